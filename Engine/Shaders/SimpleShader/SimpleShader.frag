@@ -10,55 +10,72 @@ struct Material {
 	sampler2D baseColourMap;
 	sampler2D specularMap;
 	sampler2D normalMap;
-	float shininess;
-	float specularStrength;
-	float brightness;
 };
 
 // Material for the shader to interface with our engine material
 uniform Material material;
-uniform bool hasNormalMap = false;
-uniform bool hasSpecularMap = false;
 
+// Material values are uploaded by the engine material only when they change
+layout(std140, binding = 0) uniform MaterialBlock {
+	float shininess;
+	float specularStrength;
+	float brightness;
+	float textureDepth;
+	int hasNormalMap;
+	int hasSpecularMap;
+} materialParams;
+
+// Lights are packed to match the std430 layout of the engine light structs
+// Each vec3 is followed by a float so nothing is padded
 struct DirLight {
 	vec3 colour;
+	float intensity;
 	vec3 ambient;
+	float pad0;
 	vec3 direction;
-	float intensity;
+	float pad1;
 };
 
 struct PointLight {
 	vec3 colour;
-	vec3 position;
 	float intensity;
+	vec3 position;
 	float linear;
 	float quadratic;
+	float pad0;
+	float pad1;
+	float pad2;
 };
 
 struct SpotLight {
 	vec3 colour;
+	float intensity;
 	vec3 position;
+	float linear;
 	vec3 direction;
+	float quadratic;
 
-	float coneAngle;
+	// Cut offs are the cosine of the cut off angle
 	float innerCutOff;
 	float outerCutOff;
-
-	float intensity;
-	float linear;
-	float quadratic;
+	float pad0;
+	float pad1;
 };
 
-#define NUM_DIR_LIGHTS 2
-uniform DirLight dirLights[NUM_DIR_LIGHTS];
+// Light buffers are uploaded once per frame by the graphics engine
+layout(std430, binding = 0) readonly buffer DirLightBuffer {
+	DirLight dirLights[];
+};
 uniform int addedDirLights = 0;
 
-#define NUM_POINT_LIGHTS 20
-uniform PointLight pointLights[NUM_POINT_LIGHTS];
+layout(std430, binding = 1) readonly buffer PointLightBuffer {
+	PointLight pointLights[];
+};
 uniform int addedPointLights = 0;
 
-#define NUM_SPOT_LIGHTS 20
-uniform SpotLight spotLights[NUM_SPOT_LIGHTS];
+layout(std430, binding = 2) readonly buffer SpotLightBuffer {
+	SpotLight spotLights[];
+};
 uniform int addedSpotLights = 0;
 
 out vec4 finalColour;
@@ -75,16 +92,17 @@ void main() {
 	if (texture(material.baseColourMap, fTexCoords).a < 0.1f) discard;
 
 	// Base colour map value that the object starts as
-	vec3 baseColour = texture(material.baseColourMap, fTexCoords).rgb * fColour * material.brightness;
+	vec3 baseColour = texture(material.baseColourMap, fTexCoords).rgb * fColour * materialParams.brightness;
 
 	// Specular map value that the object starts as
 	vec3 specularColour = texture(material.specularMap, fTexCoords).rgb;
 
 	// Normal colour map value that the object starts as
 	vec3 normals;
-	if (hasNormalMap) {
-		vec3 normalColour = texture(material.normalMap, fTexCoords).rgb;
-		normals = normalize(normalColour * 2.0f - 1.0f);
+	if (materialParams.hasNormalMap != 0) {
+		// Normal maps are compressed to two channels, rebuild z from x and y
+		vec2 normalXY = texture(material.normalMap, fTexCoords).rg * 2.0f - 1.0f;
+		normals = vec3(normalXY, sqrt(max(1.0f - dot(normalXY, normalXY), 0.0f)));
 		normals = normalize(fTBN * normals);
 	} else {
 		normals = normalize(fTBN * vec3(0.0f, 0.0f, 1.0f));
@@ -116,14 +134,14 @@ void main() {
 
 		// Specular power algorithm
 		// Caulculate the shininess of the model
-		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), material.shininess);
+		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), materialParams.shininess);
 		vec3 specular = specularColour * specPower;
-		specular *= material.specularStrength;
+		specular *= materialParams.specularStrength;
 		specular *= dirLights[i].intensity;
 
 		// Add our light values together to get the results
 		result += ambientLight + lightColour;
-		if (hasSpecularMap) result += specular;
+		if (materialParams.hasSpecularMap != 0) result += specular;
 	}
 
 	// ------------ POINT LIGHTS
@@ -163,14 +181,14 @@ void main() {
 
 		// Specular power algorithm
 		// Caulculate the shininess of the model
-		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), material.shininess);
+		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), materialParams.shininess);
 		vec3 specular = specularColour * specPower;
-		specular *= material.specularStrength;
+		specular *= materialParams.specularStrength;
 		specular *= pointLights[i].intensity;
 
 		// Add our light values together to get the results
 		result += lightColour;
-		if (hasSpecularMap) result += specular;
+		if (materialParams.hasSpecularMap != 0) result += specular;
 	}
 
 	// ------------ SPOT LIGHTS
@@ -218,15 +236,15 @@ void main() {
 
 		// Specular power algorithm
 		// Caulculate the shininess of the model
-		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), material.shininess);
+		float specPower = pow(max(dot(viewDir, reflectDir), 0.0f), materialParams.shininess);
 		vec3 specular = specularColour * specPower;
-		specular *= material.specularStrength;
+		specular *= materialParams.specularStrength;
 		specular *= spotLights[i].intensity * spotLightIntensity;
 		specular *= spotLightIntensity;
 
 		// Add our light values together to get the results
 		result += lightColour;
-		if (hasSpecularMap) result += specular;
+		if (materialParams.hasSpecularMap != 0) result += specular;
 	}
 	
 	finalColour = vec4(result * brightness, 1.0f);
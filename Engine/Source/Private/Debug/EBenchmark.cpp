@@ -0,0 +1,624 @@
+#include "Debug/EBenchmark.h"
+#include "Math/ESpatialHash.h"
+#include "Math/ESBox.h"
+#include "Math/ESTransform.h"
+#include "Graphics/EShaderProgram.h"
+#include "Graphics/ESLight.h"
+#include "Graphics/ESMaterial.h"
+#include "Graphics/ELightBuffer.h"
+#include "Graphics/EModel.h"
+#include "Graphics/ESCamera.h"
+#include "Graphics/EMeshOptimizer.h"
+#include "Graphics/ETexture.h"
+#include "Graphics/ETextureCompressor.h"
+
+// External Libs
+#include <SDL/SDL.h>
+#include <GLEW/glew.h>
+#include <GLM/gtc/type_ptr.hpp>
+#include <ASSIMP/Importer.hpp>
+#include <ASSIMP/scene.h>
+#include <ASSIMP/postprocess.h>
+#include <STB_IMAGE/stb_image.h>
+
+// System Libs
+#include <chrono>
+#include <random>
+#include <filesystem>
+#include <cmath>
+
+bool EBenchmark::Run(const EString& name)
+{
+	if (name == "collision") {
+		RunCollisionBenchmark();
+		return true;
+	}
+
+	if (name == "draw") {
+		RunDrawBenchmark();
+		return true;
+	}
+
+	if (name == "mesh") {
+		RunMeshBenchmark();
+		return true;
+	}
+
+	if (name == "texture") {
+		RunTextureBenchmark();
+		return true;
+	}
+
+	if (name == "compressor") {
+		return RunCompressorChecks();
+	}
+
+	EDebug::Log("No benchmark named: " + name, LT_ERROR);
+	return false;
+}
+
+void EBenchmark::RunCollisionBenchmark()
+{
+	typedef std::chrono::high_resolution_clock EClock;
+
+	// Fixed seed so runs can be compared
+	std::default_random_engine generator(1234);
+
+	// Frames averaged for each collider count
+	const EUi32 frames = 20;
+
+	// Brute force gets too slow to be worth waiting for above this
+	const EUi32 maxBruteForceColliders = 5000;
+
+	EDebug::Log("\nCollision benchmark (average of " + toEString(frames) + " frames)");
+	EDebug::Log("colliders | broadphase ms | ns per collider | pairs | overlaps | brute force ms");
+
+	for (const EUi32 colliders : { 100U, 500U, 1000U, 2500U, 5000U, 10000U, 20000U }) {
+		// Grow the play area with the collider count so density stays the same as the game
+		// Roughly 60 colliders in the 600 x 600 play area
+		const float halfArea = 40.0f * std::sqrt((float)colliders);
+		std::uniform_real_distribution<float> position(-halfArea, halfArea);
+		std::uniform_real_distribution<float> height(0.0f, 20.0f);
+		std::uniform_int_distribution<int> shape(0, 9);
+
+		// Mix of bullet, character and wall sized boxes
+		TArray<ESBox> boxes;
+		boxes.reserve(colliders);
+		for (EUi32 i = 0; i < colliders; ++i) {
+			glm::vec3 halfSize = glm::vec3(4.0f);
+			const int shapeType = shape(generator);
+
+			if (shapeType == 0)
+				halfSize = glm::vec3(47.5f, 45.0f, 5.0f);
+			else if (shapeType < 4)
+				halfSize = glm::vec3(5.0f, 20.0f, 5.0f);
+
+			boxes.push_back({ { position(generator), height(generator), position(generator) }, halfSize });
+		}
+
+		ESpatialHash broadphase;
+		size_t pairs = 0;
+		size_t overlaps = 0;
+
+		const auto start = EClock::now();
+		for (EUi32 frame = 0; frame < frames; ++frame) {
+			broadphase.Clear();
+			for (EUi32 i = 0; i < colliders; ++i) {
+				broadphase.Insert(boxes[i], i);
+			}
+
+			// Narrowphase on the pairs that share a cell
+			overlaps = 0;
+			const auto& found = broadphase.FindPairs();
+			for (const auto& [a, b] : found) {
+				if (ESBox::BoxOverlap(boxes[a], boxes[b]))
+					++overlaps;
+			}
+			pairs = found.size();
+		}
+		const double broadphaseMs = std::chrono::duration<double, std::milli>(EClock::now() - start).count() / frames;
+
+		// Old every object against every object loop for comparison
+		EString bruteForceText = "skipped";
+		if (colliders <= maxBruteForceColliders) {
+			size_t bruteOverlaps = 0;
+			const auto bruteStart = EClock::now();
+			for (EUi32 i = 0; i < colliders; ++i) {
+				for (EUi32 j = 0; j < colliders; ++j) {
+					if (i != j && ESBox::BoxOverlap(boxes[i], boxes[j]))
+						++bruteOverlaps;
+				}
+			}
+			bruteForceText = toEString(std::chrono::duration<double, std::milli>(EClock::now() - bruteStart).count());
+
+			// Each overlap is found from both sides in the brute force loop
+			if (bruteOverlaps != overlaps * 2)
+				EDebug::Log("Broadphase missed overlaps against brute force", LT_ERROR);
+		}
+
+		EDebug::Log(toEString(colliders) + " | " + toEString(broadphaseMs) + " | " 
+			+ toEString(broadphaseMs * 1000000.0 / colliders) + " | " + toEString(pairs) + " | "
+			+ toEString(overlaps) + " | " + bruteForceText);
+	}
+}
+
+// Set the uniforms of one draw by looking up every uniform name, the way the shader program used to
+// Kept so the draw benchmark can compare against the cached locations
+static void SetUniformsWithNameLookups(EUi32 programID, const glm::mat4& view, const glm::mat4& viewProjection,
+	const ELightBuffer& lightBuffer)
+{
+	glUniformMatrix4fv(glGetUniformLocation(programID, "view"), 1, GL_FALSE, glm::value_ptr(view));
+	glUniformMatrix4fv(glGetUniformLocation(programID, "viewProjection"), 1, GL_FALSE, glm::value_ptr(viewProjection));
+	glUniform1f(glGetUniformLocation(programID, "textureDepth"), 1.0f);
+	glUniform1f(glGetUniformLocation(programID, "brightness"), 1.0f);
+	glUniform1i(glGetUniformLocation(programID, "addedDirLights"), (int)lightBuffer.GetDirLightCount());
+	glUniform1i(glGetUniformLocation(programID, "addedPointLights"), (int)lightBuffer.GetPointLightCount());
+	glUniform1i(glGetUniformLocation(programID, "addedSpotLights"), (int)lightBuffer.GetSpotLightCount());
+}
+
+// Set the same uniforms as SetUniformsWithNameLookups through the locations cached when the shader linked
+static void SetUniformsWithCachedLocations(const EShaderProgram& shader, const glm::mat4& view, const glm::mat4& viewProjection,
+	const ELightBuffer& lightBuffer)
+{
+	glUniformMatrix4fv(shader.GetUniformLocation(U_VIEW), 1, GL_FALSE, glm::value_ptr(view));
+	glUniformMatrix4fv(shader.GetUniformLocation(U_VIEW_PROJECTION), 1, GL_FALSE, glm::value_ptr(viewProjection));
+	glUniform1f(shader.GetUniformLocation(U_TEXTURE_DEPTH), 1.0f);
+	glUniform1f(shader.GetUniformLocation(U_BRIGHTNESS), 1.0f);
+	glUniform1i(shader.GetUniformLocation(U_ADDED_DIR_LIGHTS), (int)lightBuffer.GetDirLightCount());
+	glUniform1i(shader.GetUniformLocation(U_ADDED_POINT_LIGHTS), (int)lightBuffer.GetPointLightCount());
+	glUniform1i(shader.GetUniformLocation(U_ADDED_SPOT_LIGHTS), (int)lightBuffer.GetSpotLightCount());
+}
+
+void EBenchmark::RunDrawBenchmark()
+{
+	typedef std::chrono::high_resolution_clock EClock;
+
+	// Hidden window for an OpenGL context, same context settings as the game
+	if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+		EDebug::Log("Draw benchmark failed to initialise SDL: " + EString(SDL_GetError()), LT_ERROR);
+		return;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 6);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
+
+	SDL_Window* sdlWindow = SDL_CreateWindow("Draw Benchmark", 0, 0, 64, 64, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	SDL_GLContext glContext = sdlWindow ? SDL_GL_CreateContext(sdlWindow) : nullptr;
+
+	if (!glContext || glewInit() != GLEW_OK) {
+		EDebug::Log("Draw benchmark failed to create an OpenGL context: " + EString(SDL_GetError()), LT_ERROR);
+		if (sdlWindow)
+			SDL_DestroyWindow(sdlWindow);
+		SDL_Quit();
+		return;
+	}
+
+	SDL_GL_SetSwapInterval(0);
+
+	{
+		// The shader, mesh and buffers need deleting before the context
+		const TShared<EShaderProgram> shader = TMakeShared<EShaderProgram>();
+		if (!shader->InitShader("Shaders/SimpleShader/SimpleShader.vertex", "Shaders/SimpleShader/SimpleShader.frag")) {
+			EDebug::Log("Draw benchmark failed to load the simple shader", LT_ERROR);
+		}
+		else {
+			// One small triangle so the GPU cost does not hide the submission cost
+			std::vector<ESVertexData> vertices(3);
+			vertices[1].m_position[0] = 1.0f;
+			vertices[2].m_position[1] = 1.0f;
+
+			EMesh mesh;
+			mesh.CreateMesh(vertices, { 0, 1, 2 }, ESVertexLayout::Create(0, vertices));
+
+			const TShared<ESMaterial> material = TMakeShared<ESMaterial>();
+
+			// Every light slot the old uniform arrays had
+			TArray<TShared<ESLight>> lights;
+			for (EUi32 i = 0; i < 2; ++i)
+				lights.push_back(TMakeShared<ESDirLight>());
+			for (EUi32 i = 0; i < 20; ++i)
+				lights.push_back(TMakeShared<ESPointLight>());
+			for (EUi32 i = 0; i < 20; ++i)
+				lights.push_back(TMakeShared<ESSpotLight>());
+
+			ELightBuffer lightBuffer;
+			const TShared<ESCamera> camera = TMakeShared<ESCamera>();
+			const glm::mat4 view = camera->GetViewMatrix(1.0f);
+			const glm::mat4 viewProjection = camera->GetProjectionMatrix() * view;
+
+			const EUi32 frames = 20;
+			const EUi32 drawsPerFrame = 2000;
+
+			// One instance per draw, uploaded once as only the uniform submission is timed
+			TArray<ESInstanceData> instances(drawsPerFrame);
+			for (EUi32 draw = 0; draw < drawsPerFrame; ++draw)
+				instances[draw].world = glm::translate(glm::mat4(1.0f), glm::vec3((float)draw, 0.0f, -10.0f));
+
+			EUi32 instanceBuffer = 0;
+			glGenBuffers(1, &instanceBuffer);
+			glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+			glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(instances.size() * sizeof(ESInstanceData)), instances.data(), GL_STATIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			EDebug::Log("\nDraw benchmark (" + toEString(drawsPerFrame) + " draws, " + toEString(lights.size())
+				+ " lights, average of " + toEString(frames) + " frames)");
+			EDebug::Log("path | submit ms per frame | ns per draw");
+
+			// Both paths make the same draws and set the same uniforms, only the location lookup differs
+			double nsPerDraw[2] = { 0.0, 0.0 };
+			for (EUi32 path = 0; path < 2; ++path) {
+				double submitMs = 0.0;
+
+				for (EUi32 frame = 0; frame < frames; ++frame) {
+					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+					const auto start = EClock::now();
+
+					shader->Activate();
+					lightBuffer.Upload(lights);
+					material->Bind();
+
+					glBindVertexArray(mesh.GetVAO());
+					mesh.AttachInstanceBuffer(instanceBuffer);
+					for (EUi32 draw = 0; draw < drawsPerFrame; ++draw) {
+						if (path == 0)
+							SetUniformsWithNameLookups(shader->GetProgramID(), view, viewProjection, lightBuffer);
+						else
+							SetUniformsWithCachedLocations(*shader, view, viewProjection, lightBuffer);
+
+						mesh.Draw(1, draw);
+					}
+					glBindVertexArray(0);
+
+					submitMs += std::chrono::duration<double, std::milli>(EClock::now() - start).count();
+
+					// Wait for the GPU outside the timer so frames don't queue up
+					glFinish();
+				}
+
+				submitMs /= frames;
+				nsPerDraw[path] = submitMs * 1000000.0 / drawsPerFrame;
+				EDebug::Log(EString(path == 0 ? "name lookups" : "cached locations") + " | " + toEString(submitMs) + " | "
+					+ toEString(nsPerDraw[path]));
+			}
+
+			if (nsPerDraw[1] > 0.0)
+				EDebug::Log("Cached uniform locations are " + toEString(nsPerDraw[0] / nsPerDraw[1]) + "x faster per draw", LT_SUCCESS);
+
+			glDeleteBuffers(1, &instanceBuffer);
+		}
+	}
+
+	SDL_GL_DeleteContext(glContext);
+	SDL_DestroyWindow(sdlWindow);
+	SDL_Quit();
+}
+
+void EBenchmark::RunMeshBenchmark()
+{
+	EDebug::Log("\nMesh benchmark (FIFO cache of " + toEString(EMeshOptimizer::cacheSize) + " vertices)");
+	EDebug::Log("model | triangles | file vertices | optimised vertices | file ACMR | optimised ACMR");
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator("Models")) {
+		const EString extension = entry.path().extension().string();
+		if (extension != ".fbx" && extension != ".gltf" && extension != ".obj")
+			continue;
+
+		const EString path = entry.path().generic_string();
+
+		// Faces as stored in the file, the way models were imported before optimisation
+		Assimp::Importer fileImporter;
+		const auto fileScene = fileImporter.ReadFile(path, aiProcess_Triangulate | aiProcess_CalcTangentSpace);
+
+		// Faces after the model import
+		Assimp::Importer importer;
+		const auto scene = importer.ReadFile(path, EModel::importFlags);
+
+		if (!fileScene || !scene) {
+			EDebug::Log("Mesh benchmark failed to import: " + path, LT_WARNING);
+			continue;
+		}
+
+		EUi32 triangles = 0, fileVertices = 0, optimisedVertices = 0;
+		double fileMisses = 0.0, optimisedMisses = 0.0;
+
+		for (EUi32 i = 0; i < fileScene->mNumMeshes; ++i) {
+			const aiMesh* aMesh = fileScene->mMeshes[i];
+
+			TArray<EUi32> indices;
+			for (EUi32 j = 0; j < aMesh->mNumFaces; ++j) {
+				for (EUi32 k = 0; k < aMesh->mFaces[j].mNumIndices; ++k) {
+					indices.push_back(aMesh->mFaces[j].mIndices[k]);
+				}
+			}
+
+			fileVertices += aMesh->mNumVertices;
+			fileMisses += EMeshOptimizer::ComputeACMR(indices, aMesh->mNumVertices) * (indices.size() / 3);
+		}
+
+		for (EUi32 i = 0; i < scene->mNumMeshes; ++i) {
+			const aiMesh* aMesh = scene->mMeshes[i];
+
+			// Only the positions matter to the optimiser
+			TArray<ESVertexData> vertices(aMesh->mNumVertices);
+			for (EUi32 j = 0; j < aMesh->mNumVertices; ++j) {
+				vertices[j].m_position[0] = aMesh->mVertices[j].x;
+				vertices[j].m_position[1] = aMesh->mVertices[j].y;
+				vertices[j].m_position[2] = aMesh->mVertices[j].z;
+			}
+
+			TArray<EUi32> indices;
+			for (EUi32 j = 0; j < aMesh->mNumFaces; ++j) {
+				for (EUi32 k = 0; k < aMesh->mFaces[j].mNumIndices; ++k) {
+					indices.push_back(aMesh->mFaces[j].mIndices[k]);
+				}
+			}
+
+			const ESMeshOptimizeStats stats = EMeshOptimizer::Optimize(vertices, indices);
+			triangles += stats.triangles;
+			optimisedVertices += (EUi32)vertices.size();
+			optimisedMisses += stats.acmrAfter * stats.triangles;
+		}
+
+		if (triangles == 0)
+			continue;
+
+		EDebug::Log(path + " | " + toEString(triangles) + " | " + toEString(fileVertices) + " | " + toEString(optimisedVertices)
+			+ " | " + toEString(fileMisses / triangles) + " | " + toEString(optimisedMisses / triangles));
+	}
+}
+
+void EBenchmark::RunTextureBenchmark()
+{
+	typedef std::chrono::high_resolution_clock EClock;
+
+	EDebug::Log("\nTexture benchmark (uncompressed is RGBA8 with mips, error is over the channels the format keeps)");
+	EDebug::Log("texture | size | format | decode ms | compress ms | uncompressed KB | compressed KB | ratio | PSNR dB");
+
+	size_t totalUncompressed = 0, totalCompressed = 0;
+
+	for (const EString folder : { "Textures", "Models" }) {
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(folder)) {
+			const EString extension = entry.path().extension().string();
+			if (extension != ".png" && extension != ".jpg" && extension != ".jpeg")
+				continue;
+
+			const EString path = entry.path().generic_string();
+
+			// Time the decode every launch paid before textures were cooked
+			int width = 0, height = 0, channels = 0;
+			const auto decodeStart = EClock::now();
+			unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+			const double decodeMs = std::chrono::duration<double, std::milli>(EClock::now() - decodeStart).count();
+
+			if (pixels == nullptr || channels < 3) {
+				EDebug::Log("Texture benchmark failed to load: " + path, LT_WARNING);
+				stbi_image_free(pixels);
+				continue;
+			}
+
+			const bool normalMap = ETexture::GetTypeFromName(path) == TT_NORMAL;
+
+			const EETextureFormat format = ETextureCompressor::ChooseFormat(pixels, width, height, channels, normalMap);
+
+			ESCompressedImage image;
+			const auto compressStart = EClock::now();
+			ETextureCompressor::Compress(pixels, width, height, channels, format, image);
+			const double compressMs = std::chrono::duration<double, std::milli>(EClock::now() - compressStart).count();
+
+			// Compare the top mip against the source
+			TArray<EUi8> decoded;
+			ETextureCompressor::DecodeMip(format, image.data.data(), width, height, decoded);
+
+			const int errorChannels = format == TF_BC5 ? 2 : format == TF_BC3 ? 4 : 3;
+			double squaredError = 0.0;
+			for (size_t i = 0; i < (size_t)width * height; ++i) {
+				for (int channel = 0; channel < errorChannels; ++channel) {
+					const double difference = (double)decoded[i * 4 + channel] - pixels[i * channels + channel];
+					squaredError += difference * difference;
+				}
+			}
+
+			const double meanError = squaredError / ((double)width * height * errorChannels);
+			const EString psnrText = meanError > 0.0 ? toEString(10.0 * std::log10(255.0 * 255.0 / meanError)) : "exact";
+
+			stbi_image_free(pixels);
+
+			const size_t uncompressedSize = (size_t)width * height * 4 * 4 / 3;
+			totalUncompressed += uncompressedSize;
+			totalCompressed += image.data.size();
+
+			const EString formatNames[] = { "RGBA8", "BC1", "BC3", "BC5" };
+			EDebug::Log(path + " | " + toEString(width) + "x" + toEString(height) + " | " + formatNames[format]
+				+ " | " + toEString(decodeMs) + " | " + toEString(compressMs)
+				+ " | " + toEString(uncompressedSize / 1024) + " | " + toEString(image.data.size() / 1024)
+				+ " | " + toEString((double)uncompressedSize / image.data.size()) + " | " + psnrText);
+		}
+	}
+
+	if (totalCompressed > 0) {
+		EDebug::Log("Total | " + toEString(totalUncompressed / 1024) + " KB uncompressed | " + toEString(totalCompressed / 1024)
+			+ " KB compressed | " + toEString((double)totalUncompressed / totalCompressed) + "x smaller");
+	}
+}
+
+// Compare the pixels of a block against the block after an encode and decode
+// Only the channels from firstChannel to lastChannel are compared
+static bool CheckBlockRoundTrip(EETextureFormat format, const EUi8* rgba, int firstChannel, int lastChannel, int tolerance,
+	const EString& name)
+{
+	EUi8 block[16];
+	EUi8 decoded[64];
+	ETextureCompressor::EncodeBlock(format, rgba, block);
+	ETextureCompressor::DecodeBlock(format, block, decoded);
+
+	int maxError = 0;
+	for (EUi32 i = 0; i < 16; ++i) {
+		for (int channel = firstChannel; channel <= lastChannel; ++channel)
+			maxError = std::max(maxError, std::abs((int)rgba[i * 4 + channel] - (int)decoded[i * 4 + channel]));
+	}
+
+	if (maxError > tolerance) {
+		EDebug::Log("FAIL " + name + " round trip, max error " + toEString(maxError) + " over " + toEString(tolerance), LT_ERROR);
+		return false;
+	}
+
+	EDebug::Log("pass " + name + " round trip, max error " + toEString(maxError));
+	return true;
+}
+
+// Compress an image and check the PSNR of the first mip over the channels the format keeps
+static bool CheckImagePSNR(EETextureFormat format, const TArray<EUi8>& rgba, EUi32 width, EUi32 height, int channelCount,
+	double minPSNR, const EString& name)
+{
+	ESCompressedImage image;
+	if (!ETextureCompressor::Compress(rgba.data(), width, height, 4, format, image)) {
+		EDebug::Log("FAIL " + name + " failed to compress", LT_ERROR);
+		return false;
+	}
+
+	TArray<EUi8> decoded;
+	ETextureCompressor::DecodeMip(format, image.data.data(), width, height, decoded);
+
+	double squaredError = 0.0;
+	for (size_t pixel = 0; pixel < (size_t)width * height; ++pixel) {
+		for (int channel = 0; channel < channelCount; ++channel) {
+			const double delta = (double)rgba[pixel * 4 + channel] - decoded[pixel * 4 + channel];
+			squaredError += delta * delta;
+		}
+	}
+
+	const double meanError = squaredError / ((double)width * height * channelCount);
+	const double psnr = meanError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanError) : 99.0;
+
+	if (psnr < minPSNR) {
+		EDebug::Log("FAIL " + name + " PSNR " + toEString(psnr) + " dB under " + toEString(minPSNR) + " dB", LT_ERROR);
+		return false;
+	}
+
+	EDebug::Log("pass " + name + " PSNR " + toEString(psnr) + " dB");
+	return true;
+}
+
+bool EBenchmark::RunCompressorChecks()
+{
+	EDebug::Log("\nTexture compressor checks");
+
+	bool passed = true;
+
+	// --------- SOLID BLOCKS
+	// Solid colours only lose the 565 rounding, solid channels are exact
+	EUi8 solid[64];
+	for (EUi32 i = 0; i < 16; ++i) {
+		solid[i * 4] = 200;
+		solid[i * 4 + 1] = 100;
+		solid[i * 4 + 2] = 50;
+		solid[i * 4 + 3] = 128;
+	}
+
+	passed &= CheckBlockRoundTrip(TF_BC1, solid, 0, 2, 4, "BC1 solid");
+	passed &= CheckBlockRoundTrip(TF_BC3, solid, 0, 2, 4, "BC3 solid colour");
+	passed &= CheckBlockRoundTrip(TF_BC3, solid, 3, 3, 0, "BC3 solid alpha");
+	passed &= CheckBlockRoundTrip(TF_BC5, solid, 0, 1, 0, "BC5 solid");
+
+	// --------- GRADIENT BLOCKS
+	// Colours use the 4 levels a colour block can hold along one line
+	// Channels use the 8 levels a channel block can hold
+	EUi8 gradient[64];
+	for (EUi32 y = 0; y < 4; ++y) {
+		for (EUi32 x = 0; x < 4; ++x) {
+			EUi8* pixel = &gradient[(y * 4 + x) * 4];
+			const EUi8 level = (EUi8)(x * 85);
+			const EUi8 channelLevel = (EUi8)(((y * 4 + x) % 8) * 255 / 7);
+
+			pixel[0] = level;
+			pixel[1] = (EUi8)(255 - level);
+			pixel[2] = 128;
+			pixel[3] = channelLevel;
+		}
+	}
+
+	passed &= CheckBlockRoundTrip(TF_BC1, gradient, 0, 2, 8, "BC1 gradient");
+	passed &= CheckBlockRoundTrip(TF_BC3, gradient, 0, 2, 8, "BC3 gradient colour");
+	passed &= CheckBlockRoundTrip(TF_BC3, gradient, 3, 3, 2, "BC3 gradient alpha");
+
+	for (EUi32 i = 0; i < 16; ++i) {
+		gradient[i * 4] = gradient[i * 4 + 3];
+		gradient[i * 4 + 1] = (EUi8)(255 - gradient[i * 4 + 3]);
+	}
+
+	passed &= CheckBlockRoundTrip(TF_BC5, gradient, 0, 1, 2, "BC5 gradient");
+
+	// --------- PSNR
+	// A smooth image should keep most of its detail, a broken encoder falls far below these
+	const EUi32 size = 64;
+	TArray<EUi8> image((size_t)size * size * 4);
+	for (EUi32 y = 0; y < size; ++y) {
+		for (EUi32 x = 0; x < size; ++x) {
+			EUi8* pixel = &image[((size_t)y * size + x) * 4];
+			pixel[0] = (EUi8)(x * 4);
+			pixel[1] = (EUi8)(y * 4);
+			pixel[2] = (EUi8)((x + y) * 2);
+			pixel[3] = (EUi8)(255 - x * 4);
+		}
+	}
+
+	passed &= CheckImagePSNR(TF_BC1, image, size, size, 3, 35.0, "BC1 smooth image");
+	passed &= CheckImagePSNR(TF_BC3, image, size, size, 4, 35.0, "BC3 smooth image");
+	passed &= CheckImagePSNR(TF_BC5, image, size, size, 2, 40.0, "BC5 smooth image");
+
+	// --------- NORMAL MAP MIPS
+	// Half the pixels face up and half face along x, so every 2x2 averages to a normal
+	// shorter than 1 that has to be renormalised to (0.707, 0, 0.707)
+	for (EUi32 y = 0; y < size; ++y) {
+		for (EUi32 x = 0; x < size; ++x) {
+			EUi8* pixel = &image[((size_t)y * size + x) * 4];
+			const bool facesUp = (x + y) % 2 == 0;
+			pixel[0] = facesUp ? 128 : 255;
+			pixel[1] = 128;
+			pixel[2] = facesUp ? 255 : 128;
+			pixel[3] = 255;
+		}
+	}
+
+	ESCompressedImage normalMap;
+	if (!ETextureCompressor::Compress(image.data(), size, size, 4, TF_BC5, normalMap)) {
+		EDebug::Log("FAIL normal map failed to compress", LT_ERROR);
+		passed = false;
+	}
+	else {
+		const glm::vec3 expected = glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f));
+		float worstDot = 1.0f;
+
+		const EUi8* mipData = normalMap.data.data() + ETextureCompressor::GetMipSize(TF_BC5, size, size);
+		EUi32 mipSize = size / 2;
+		for (EUi32 level = 1; level < normalMap.mipCount; ++level) {
+			TArray<EUi8> decoded;
+			ETextureCompressor::DecodeMip(TF_BC5, mipData, mipSize, mipSize, decoded);
+
+			// The shader rebuilds z from x and y, which only matches the averaged normal if x and y were renormalised
+			for (size_t pixel = 0; pixel < (size_t)mipSize * mipSize; ++pixel) {
+				const float normalX = decoded[pixel * 4] / 127.5f - 1.0f;
+				const float normalY = decoded[pixel * 4 + 1] / 127.5f - 1.0f;
+				const float normalZ = std::sqrt(std::max(1.0f - normalX * normalX - normalY * normalY, 0.0f));
+				worstDot = std::min(worstDot, glm::dot(glm::vec3(normalX, normalY, normalZ), expected));
+			}
+
+			mipData += ETextureCompressor::GetMipSize(TF_BC5, mipSize, mipSize);
+			mipSize = std::max(mipSize / 2, 1U);
+		}
+
+		// Without renormalising x is 0.5 and the rebuilt normal is 15 degrees off
+		if (worstDot < 0.999f) {
+			EDebug::Log("FAIL normal map mips are not unit length, worst dot " + toEString(worstDot), LT_ERROR);
+			passed = false;
+		}
+		else {
+			EDebug::Log("pass normal map mips are unit length, worst dot " + toEString(worstDot));
+		}
+	}
+
+	EDebug::Log(passed ? "Texture compressor checks passed" : "Texture compressor checks failed", passed ? LT_SUCCESS : LT_ERROR);
+	return passed;
+}
@@ -0,0 +1,256 @@
+#include "Debug/EProfiler.h"
+
+#if EPROFILING_ENABLED
+
+// System Libs
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+// Number of samples kept per zone for the summary
+static constexpr EUi32 summarySampleCount = 512;
+
+// Most events kept in a capture so a forgotten capture can't use all the memory
+static constexpr EUi64 maxCaptureEvents = 2000000;
+
+// Rolling samples for one zone
+struct ESProfileZoneStats {
+	// Durations in nanoseconds stored in a circle
+	TArray<EUi64> samples;
+
+	// Next sample to overwrite
+	EUi32 next = 0;
+};
+
+// An event with the thread it came from, kept for the capture
+struct ESCapturedEvent {
+	ESProfileEvent event;
+	EUi32 threadID = 0;
+};
+
+// Profiler state shared by all threads
+struct ESProfilerState {
+	// Guards the buffer list, only locked when a thread records for the first time or in EndFrame
+	std::mutex buffersMutex;
+
+	// Ring buffer for every thread that has recorded a zone
+	TArray<TUnique<EProfileRingBuffer>> buffers;
+
+	// Rolling samples for each zone name
+	std::unordered_map<std::string_view, ESProfileZoneStats> zoneStats;
+
+	// Events kept while capturing
+	TArray<ESCapturedEvent> captureEvents;
+
+	// Time the capture started, trace times are relative to this
+	EUi64 captureStart = 0;
+
+	bool capturing = false;
+};
+
+static ESProfilerState& GetState()
+{
+	static ESProfilerState state;
+	return state;
+}
+
+EProfileRingBuffer::EProfileRingBuffer(EUi32 threadID)
+{
+	m_head = 0;
+	m_tail = 0;
+	m_dropped = 0;
+	m_threadID = threadID;
+}
+
+void EProfileRingBuffer::Push(const ESProfileEvent& event)
+{
+	const EUi32 head = m_head.load(std::memory_order_relaxed);
+
+	// Drop the event if the reader hasn't caught up
+	if (head - m_tail.load(std::memory_order_acquire) >= capacity) {
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	m_events[head % capacity] = event;
+
+	// Publish the event to the reader
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+bool EProfileRingBuffer::Pop(ESProfileEvent& event)
+{
+	const EUi32 tail = m_tail.load(std::memory_order_relaxed);
+
+	if (tail == m_head.load(std::memory_order_acquire))
+		return false;
+
+	event = m_events[tail % capacity];
+
+	// Give the slot back to the writer
+	m_tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+EUi64 EProfiler::Now()
+{
+	return (EUi64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void EProfiler::Record(const char* name, EUi64 start, EUi64 end)
+{
+	GetThreadBuffer().Push({ name, start, end });
+}
+
+void EProfiler::EndFrame()
+{
+	ESProfilerState& state = GetState();
+	std::lock_guard<std::mutex> lock(state.buffersMutex);
+
+	ESProfileEvent event;
+	for (const auto& buffer : state.buffers) {
+		while (buffer->Pop(event)) {
+			// Add the duration to the zones rolling samples
+			ESProfileZoneStats& stats = state.zoneStats[event.name];
+			const EUi64 duration = event.end - event.start;
+
+			if (stats.samples.size() < summarySampleCount) {
+				stats.samples.push_back(duration);
+			}
+			else {
+				stats.samples[stats.next] = duration;
+				stats.next = (stats.next + 1) % summarySampleCount;
+			}
+
+			// Keep the whole event for the trace
+			if (state.capturing && state.captureEvents.size() < maxCaptureEvents) {
+				state.captureEvents.push_back({ event, buffer->GetThreadID() });
+			}
+		}
+	}
+}
+
+void EProfiler::LogSummary()
+{
+	ESProfilerState& state = GetState();
+	std::lock_guard<std::mutex> lock(state.buffersMutex);
+
+	// Sort the zones by name so the summary is easy to read
+	TArray<std::string_view> names;
+	for (const auto& [name, stats] : state.zoneStats) {
+		names.push_back(name);
+	}
+	std::sort(names.begin(), names.end());
+
+	EDebug::Log("\nProfiler summary (ms) | min | avg | p99 | samples");
+
+	TArray<EUi64> sorted;
+	for (const std::string_view name : names) {
+		const ESProfileZoneStats& stats = state.zoneStats[name];
+		if (stats.samples.empty())
+			continue;
+
+		sorted.assign(stats.samples.begin(), stats.samples.end());
+		std::sort(sorted.begin(), sorted.end());
+
+		EUi64 total = 0;
+		for (const EUi64 sample : sorted) {
+			total += sample;
+		}
+
+		const double min = sorted.front() / 1000000.0;
+		const double avg = (double)total / sorted.size() / 1000000.0;
+		const double p99 = sorted[(sorted.size() - 1) * 99 / 100] / 1000000.0;
+
+		EDebug::Log(EString(name) + " | " + std::to_string(min) + " | " + std::to_string(avg) + " | "
+			+ std::to_string(p99) + " | " + std::to_string(sorted.size()));
+	}
+
+	// Warn if any thread recorded more than its buffer could hold
+	for (const auto& buffer : state.buffers) {
+		if (buffer->GetDroppedCount() > 0) {
+			EDebug::Log("Profiler thread " + std::to_string(buffer->GetThreadID()) + " dropped "
+				+ std::to_string(buffer->GetDroppedCount()) + " zones", LT_WARNING);
+		}
+	}
+}
+
+void EProfiler::BeginCapture()
+{
+	ESProfilerState& state = GetState();
+	std::lock_guard<std::mutex> lock(state.buffersMutex);
+
+	state.captureEvents.clear();
+	state.captureStart = Now();
+	state.capturing = true;
+
+	EDebug::Log("Profiler capture started");
+}
+
+bool EProfiler::EndCapture(const EString& path)
+{
+	ESProfilerState& state = GetState();
+	std::lock_guard<std::mutex> lock(state.buffersMutex);
+
+	state.capturing = false;
+
+	std::ofstream file(path);
+	if (!file.is_open()) {
+		EDebug::Log("Profiler failed to write capture: " + path, LT_ERROR);
+		return false;
+	}
+
+	// Complete events with times in microseconds
+	file << "{\"traceEvents\":[\n";
+	size_t written = 0;
+	for (const ESCapturedEvent& captured : state.captureEvents) {
+		// Skip zones that ended before the capture started
+		if (captured.event.end < state.captureStart)
+			continue;
+
+		// Zones that straddle the capture start are clamped to it
+		const EUi64 clampedStart = std::max(captured.event.start, state.captureStart);
+		const EUi64 start = clampedStart - state.captureStart;
+		const EUi64 duration = captured.event.end - clampedStart;
+
+		if (written++ > 0)
+			file << ",\n";
+
+		file << "{\"name\":\"" << captured.event.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << captured.threadID
+			<< ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << "}";
+	}
+	file << "\n]}\n";
+
+	EDebug::Log("Profiler capture written to " + path + " (" + std::to_string(written) + " zones)", LT_SUCCESS);
+
+	state.captureEvents.clear();
+	return true;
+}
+
+bool EProfiler::IsCapturing()
+{
+	return GetState().capturing;
+}
+
+EProfileRingBuffer& EProfiler::GetThreadBuffer()
+{
+	thread_local EProfileRingBuffer* threadBuffer = nullptr;
+
+	// Register the thread the first time it records
+	if (!threadBuffer) {
+		ESProfilerState& state = GetState();
+		std::lock_guard<std::mutex> lock(state.buffersMutex);
+
+		state.buffers.push_back(TMakeUnique<EProfileRingBuffer>((EUi32)state.buffers.size()));
+		threadBuffer = state.buffers.back().get();
+	}
+
+	return *threadBuffer;
+}
+
+#endif
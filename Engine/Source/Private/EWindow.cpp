@@ -5,6 +5,7 @@
 #include "Graphics/ESCamera.h"
 #include "Game/EGameEngine.h"
 #include "Graphics/EShaderProgram.h"
+#include "Debug/EProfiler.h"
 
 // External Libs
 #include <SDL/SDL.h>
@@ -43,6 +44,12 @@ bool EWindow::CreateWindow(const ESWindowParams& params)
 	// Assigning the parameters to the member for the window
 	m_params = params;
 
+	// Headless windows only create a graphics engine with no OpenGL
+	if (m_params.headless) {
+		m_graphicsEngine = TMakeUnique<EGraphicsEngine>();
+		return m_graphicsEngine->InitHeadless();
+	}
+
 	// Add vsync flag if selected
 	if (m_params.vsync)
 		windowFlags += SDL_WINDOW_ALLOW_HIGHDPI;
@@ -156,6 +163,42 @@ void EWindow::RegisterInput(const TShared<EInput>& m_input)
 		if (key == SDL_SCANCODE_TAB) {
 			EGameEngine::GetGameEngine()->SetFrameRate(10);
 		}
+#if EPROFILING_ENABLED
+		// Log the profiler summary
+		if (key == SDL_SCANCODE_F1) {
+			EProfiler::LogSummary();
+		}
+		// Start or stop a profiler capture
+		if (key == SDL_SCANCODE_F2) {
+			if (EProfiler::IsCapturing())
+				EProfiler::EndCapture("ProfileTrace.json");
+			else
+				EProfiler::BeginCapture();
+		}
+#endif
+		// Log the culling, draw calls and state changes of the last frame, and the asset cache and loading
+		if (key == SDL_SCANCODE_F3) {
+			const ESCullStats& cullStats = m_graphicsEngine->GetCullStats();
+			EDebug::Log("Objects considered: " + std::to_string(cullStats.objectsConsidered)
+				+ " | Objects drawn: " + std::to_string(cullStats.objectsDrawn));
+
+			const ESRenderStats& stats = m_graphicsEngine->GetRenderStats();
+			EDebug::Log("Draw calls: " + std::to_string(stats.drawCalls)
+				+ " | Instances: " + std::to_string(stats.instances)
+				+ " | Program changes: " + std::to_string(stats.programChanges)
+				+ " | Material changes: " + std::to_string(stats.materialChanges)
+				+ " | Texture binds: " + std::to_string(stats.textureBinds)
+				+ " | VAO binds: " + std::to_string(stats.vaoBinds));
+
+			const ESAssetCacheStats cacheStats = m_graphicsEngine->GetAssetCache().GetStats();
+			EDebug::Log("Cached textures: " + std::to_string(cacheStats.textures)
+				+ " | Cached materials: " + std::to_string(cacheStats.materials)
+				+ " | Hits: " + std::to_string(cacheStats.hits)
+				+ " | Misses: " + std::to_string(cacheStats.misses)
+				+ " | Evictions: " + std::to_string(cacheStats.evictions)
+				+ " | Texture memory: " + std::to_string(cacheStats.residentBytes / 1024) + " KB"
+				+ " | Assets loading: " + std::to_string(m_graphicsEngine->GetAssetManager().GetPendingCount()));
+		}
 		// Set flag to randomly change brightness
 		if (key == SDL_SCANCODE_LCTRL) {
 			m_randomlyChangeBrightness = true;
@@ -2,12 +2,27 @@
 #include "Game/GameObjects/EObject.h"
 #include "Graphics/EGraphicsEngine.h"
 #include "Graphics/EShaderProgram.h"
+#include "Graphics/ESCamera.h"
+#include "Debug/EProfiler.h"
 
 // External Libs
 #include <random>
 
-// Initialise a random generator
-std::default_random_engine RandGenerator;
+// Seed every random generator is made from, set when the engine is created
+static EUi32 s_randomSeed = std::random_device{}();
+
+// Each thread has its own generator so parallel ticks can use random numbers
+// Made on the first use on each thread from the engine seed and the worker index
+// so every worker has its own sequence and one seed repeats the whole run
+static std::default_random_engine& GetRandGenerator()
+{
+	thread_local std::default_random_engine generator = []() {
+		std::seed_seq seeds{ s_randomSeed, EJobSystem::GetWorkerIndex() };
+		return std::default_random_engine(seeds);
+	}();
+
+	return generator;
+}
 
 // DEBUG
 #include "Game/GameObjects/CustomObjects/Player.h"
@@ -51,9 +66,254 @@ bool EGameEngine::Run()
 
 void EGameEngine::DestroyObject(const TShared<EObject>& object)
 {
+	// Objects destroyed in the parallel tick are removed in PostLoop
+	if (m_deferObjectChanges) {
+		m_commandBuffers[EJobSystem::GetWorkerIndex()].objectsPendingDestroy.push_back(object);
+		return;
+	}
+
 	m_objectsPendingDestroy.push_back(object);
 }
 
+void EGameEngine::AddPoints(int points)
+{
+	// Points added in the parallel tick are added in PostLoop
+	if (m_deferObjectChanges) {
+		m_commandBuffers[EJobSystem::GetWorkerIndex()].points += points;
+		return;
+	}
+
+	m_points += points;
+}
+
+ESTimerHandle EGameEngine::SetTimer(float delay, const std::function<void()>& callback, bool repeat)
+{
+	return SetTimer(nullptr, delay, callback, repeat);
+}
+
+ESTimerHandle EGameEngine::SetTimer(const EObject* owner, float delay, const std::function<void()>& callback, bool repeat)
+{
+	// The timer wheel is only used on the main thread
+	if (m_deferObjectChanges) {
+		EDebug::Log("Timers can't be set during the parallel tick", LT_ERROR);
+		return {};
+	}
+
+	return m_timers.Add(delay, callback, repeat, owner ? owner->GetHandle() : ESObjectHandle());
+}
+
+void EGameEngine::ClearTimer(ESTimerHandle& handle)
+{
+	if (m_deferObjectChanges) {
+		EDebug::Log("Timers can't be cleared during the parallel tick", LT_ERROR);
+		return;
+	}
+
+	m_timers.Clear(handle);
+	handle = {};
+}
+
+void EGameEngine::SetLifeTime(EObject* object, float lifeTime)
+{
+	object->m_lifeTime = lifeTime;
+
+	// Objects that have not spawned start their lifetime when they spawn
+	if (!m_objectStore.IsAdded(object->GetHandle()))
+		return;
+
+	ClearTimer(object->m_lifeTimeTimer);
+
+	// The timer is owned by the object so it is dropped if the object is destroyed first
+	if (lifeTime > 0.0f) {
+		object->m_lifeTimeTimer = SetTimer(object, lifeTime, [object]() { object->Destroy(); });
+	}
+}
+
+void EGameEngine::AddObjectToSpawn(const TShared<EObject>& newObject)
+{
+	// Objects created in the parallel tick are added in PostLoop
+	// The handle is not set until then
+	if (m_deferObjectChanges) {
+		m_commandBuffers[EJobSystem::GetWorkerIndex()].objectsToBeSpawned.push_back(newObject);
+		return;
+	}
+
+	// Give the object a handle so it can be found before it spawns
+	newObject->m_handle = m_objectStore.Reserve(newObject.get());
+
+	// Add the object into the stack
+	m_objectsToBeSpawned.push_back(newObject);
+}
+
+void EGameEngine::UpdateTickList(EObject* object)
+{
+	// Objects not owned by a shared pointer yet are added to the right list when they spawn
+	TWeak<EObject> weakObject = object->weak_from_this();
+	if (weakObject.expired())
+		return;
+
+	// Changes in the parallel tick are added in PostLoop
+	if (m_deferObjectChanges) {
+		m_commandBuffers[EJobSystem::GetWorkerIndex()].tickListChanges.push_back(std::move(weakObject));
+		return;
+	}
+
+	// Lists can't change while they are being ticked so wait until PostLoop
+	m_tickListChanges.push_back(std::move(weakObject));
+}
+
+void EGameEngine::ApplyTickListChanges()
+{
+	for (const TWeak<EObject>& weakObject : m_tickListChanges) {
+		const TShared<EObject> object = weakObject.lock();
+		if (!object)
+			continue;
+
+		// Objects that have not spawned yet are added to the right list when they spawn
+		if (m_objectStore.IsAdded(object->GetHandle()) && m_objectStore.Get(object->GetHandle()) == object.get())
+			MoveToTickList(object.get());
+	}
+
+	m_tickListChanges.clear();
+}
+
+void EGameEngine::MoveToTickList(EObject* object)
+{
+	// Find the list the object needs
+	EETickList tickList = TL_NONE;
+	if (object->IsTickEnabled())
+		tickList = object->CanTickInParallel() ? TL_PARALLEL : TL_SERIAL;
+
+	if (tickList == object->m_tickList)
+		return;
+
+	RemoveFromTickList(object);
+
+	// Add to the new list
+	if (TArray<EObject*>* newList = GetTickList(tickList)) {
+		object->m_tickIndex = (EUi32)newList->size();
+		newList->push_back(object);
+	}
+
+	object->m_tickList = tickList;
+}
+
+void EGameEngine::RemoveFromTickList(EObject* object)
+{
+	TArray<EObject*>* list = GetTickList(object->m_tickList);
+	object->m_tickList = TL_NONE;
+
+	if (!list)
+		return;
+
+	// Swap the last object into its place so the remove doesn't shift the list
+	EObject* lastObject = list->back();
+	(*list)[object->m_tickIndex] = lastObject;
+	lastObject->m_tickIndex = object->m_tickIndex;
+	list->pop_back();
+}
+
+void EGameEngine::UpdateColliderList(EWorldObject* object)
+{
+	// Objects not owned by a shared pointer yet are added to the right list when they spawn
+	TWeak<EObject> weakObject = object->weak_from_this();
+	if (weakObject.expired())
+		return;
+
+	// Changes in the parallel tick are added in PostLoop
+	if (m_deferObjectChanges) {
+		m_commandBuffers[EJobSystem::GetWorkerIndex()].colliderChanges.push_back(std::move(weakObject));
+		return;
+	}
+
+	// Collisions can be added while the lists are being tested so wait until PostLoop
+	m_colliderChanges.push_back(std::move(weakObject));
+}
+
+void EGameEngine::ApplyColliderChanges()
+{
+	for (const TWeak<EObject>& weakObject : m_colliderChanges) {
+		const TShared<EObject> object = weakObject.lock();
+		if (!object)
+			continue;
+
+		// Objects that have not spawned yet are added to the right list when they spawn
+		if (m_objectStore.IsAdded(object->GetHandle()) && m_objectStore.Get(object->GetHandle()) == object.get())
+			MoveToColliderList(std::static_pointer_cast<EWorldObject>(object));
+	}
+
+	m_colliderChanges.clear();
+}
+
+void EGameEngine::MoveToColliderList(const TShared<EWorldObject>& object)
+{
+	// Find the list the object needs
+	EEColliderList colliderList = CL_NONE;
+	if (object->HasCollisions())
+		colliderList = object->IsStaticCollider() ? CL_STATIC : CL_DYNAMIC;
+
+	// The static grid holds the boxes of the static colliders so any change to them rebuilds it
+	if (colliderList == CL_STATIC || object->m_colliderList == CL_STATIC)
+		m_staticBroadphaseDirty = true;
+
+	if (colliderList == object->m_colliderList)
+		return;
+
+	// Remove from the old list, only happens when collisions change after spawning
+	if (object->m_colliderList == CL_STATIC)
+		std::erase(m_staticColliders, object);
+	else if (object->m_colliderList == CL_DYNAMIC)
+		std::erase(m_dynamicColliders, object);
+
+	// Add to the new list
+	if (colliderList == CL_STATIC)
+		m_staticColliders.push_back(object);
+	else if (colliderList == CL_DYNAMIC)
+		m_dynamicColliders.push_back(object);
+
+	object->m_colliderList = colliderList;
+}
+
+TArray<EObject*>* EGameEngine::GetTickList(EETickList tickList)
+{
+	switch (tickList) {
+	case TL_SERIAL:
+		return &m_serialTickObjects;
+	case TL_PARALLEL:
+		return &m_parallelTickObjects;
+	default:
+		return nullptr;
+	}
+}
+
+void EGameEngine::MergeCommandBuffers()
+{
+	for (ESObjectCommandBuffer& buffer : m_commandBuffers) {
+		// Give the new objects their handles and spawn them next loop
+		for (const auto& eObjectRef : buffer.objectsToBeSpawned) {
+			eObjectRef->m_handle = m_objectStore.Reserve(eObjectRef.get());
+			m_objectsToBeSpawned.push_back(eObjectRef);
+		}
+
+		m_objectsPendingDestroy.insert(m_objectsPendingDestroy.end(),
+			buffer.objectsPendingDestroy.begin(), buffer.objectsPendingDestroy.end());
+
+		m_tickListChanges.insert(m_tickListChanges.end(),
+			buffer.tickListChanges.begin(), buffer.tickListChanges.end());
+
+		m_colliderChanges.insert(m_colliderChanges.end(),
+			buffer.colliderChanges.begin(), buffer.colliderChanges.end());
+
+		m_points += buffer.points;
+
+		buffer.objectsToBeSpawned.clear();
+		buffer.objectsPendingDestroy.clear();
+		buffer.tickListChanges.clear();
+		buffer.colliderChanges.clear();
+		buffer.points = 0;
+	}
+}
+
 TWeak<EModel> EGameEngine::ImportModel(const EString& path)
 {
 	return m_window->GetGraphicsEngine()->ImportModel(path);
@@ -71,18 +331,29 @@ TShared<ESMaterial> EGameEngine::CreateMaterialB(float brightness)
 
 EGameEngine::EGameEngine()
 {
-	m_lastTickTime = 0.0f;
+	m_lastCounter = 0;
 	m_deltaTime = 0.0f;
 
 	m_defaultFrameRate = 120;
 	m_frameRate = m_defaultFrameRate;
 
-	m_timeToLoad = 0.0f;
+	m_useFixedTimeStep = true;
+	m_fixedDeltaTime = 1.0 / 60.0;
+	m_accumulator = 0.0;
+	m_maxFrameTime = 0.25;
+	m_maxTicksPerFrame = 8;
+	m_renderAlpha = 1.0f;
+
+	m_headless = false;
+	m_frameBudget = 0;
+
+	m_deferObjectChanges = false;
+	m_staticBroadphaseDirty = false;
 
 	m_points = 0;
 
-	// Set random seed
-	RandGenerator.seed((unsigned int)time(0));
+	// Set random seed, workers seed their generators from it when they first use one
+	s_randomSeed = (EUi32)time(0);
 	
 	EDebug::Log("Game engine created");
 }
@@ -96,6 +367,27 @@ EGameEngine::~EGameEngine()
 
 bool EGameEngine::Init()
 {
+	// Start the worker threads with a command buffer for each
+	m_jobSystem = TMakeUnique<EJobSystem>();
+	m_commandBuffers.resize(m_jobSystem->GetWorkerCount());
+
+	// Headless runs only need the timer, no video or GL
+	if (m_headless) {
+		if (SDL_Init(SDL_INIT_TIMER) != 0) {
+			EDebug::Log("Failed to init SDL: " + EString(SDL_GetError()), LT_ERROR);
+			return false;
+		}
+
+		// Creating the window object
+		m_window = TMakeShared<EWindow>();
+
+		// Headless window params skip the SDL window and OpenGL context
+		ESWindowParams params = { "Game Window", 0, 0, 720, 720 };
+		params.headless = true;
+
+		return m_window->CreateWindow(params);
+	}
+
 	// Initialise the components of SDL that we need
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
 		EDebug::Log("Failed to init SDL: " + EString(SDL_GetError()), LT_ERROR);
@@ -138,7 +430,8 @@ void EGameEngine::Start()
 	EDebug::Log("\nLoading...\n");
 	
 	// Register the window inputs
-	m_window->RegisterInput(m_input);
+	if (m_input)
+		m_window->RegisterInput(m_input);
 
 	// Spawn Skybox
 	CreateObject<Skybox>();
@@ -179,7 +472,7 @@ void EGameEngine::Start()
 		// Spawn Enemies
 		for (EUi32 i = 0; i < 8; i++) {
 			// Spawn enemy
-			Enemy::SpawnEnemy(player);
+			Enemy::SpawnEnemy(player->GetHandleRef<Player>());
 		}
 	}
 
@@ -221,55 +514,175 @@ void EGameEngine::Start()
 		});
 	}
 
-	// Get the time to load
-	m_timeToLoad = static_cast<double>(SDL_GetTicks64());
+	// Start timing from the end of loading
+	// Otherwise massive delta on first frame
+	m_lastCounter = SDL_GetPerformanceCounter();
 }
 
 void EGameEngine::GameLoop()
 {
+	if (m_headless) {
+		HeadlessLoop();
+		return;
+	}
+
+	// Number of performance counter ticks in a second
+	const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
 	// Keep the game open as long as the window is open
 	while (!m_window->IsPendingClose()) {
+		// Collect the zones from the last frame
+		EPROFILE_END_FRAME();
+		EPROFILE_ZONE("Frame");
+
 		// Create delta time
-		// Set the current tick time
-		// SDL_GetTicks64() gets the time since the engine started in milliseconds
-		double curTickTime = static_cast<double>(SDL_GetTicks64()) - m_timeToLoad;
-		// Convert the tick time into delta milli
-		// How much time has passed since the last frame
-		double deltaMilli = curTickTime - m_lastTickTime;
-		// Convert delta milli to seconds
-		m_deltaTime = deltaMilli / 1000;
-		// Update the last tick time to the current tick time for the loop
-		m_lastTickTime = curTickTime;
+		// SDL_GetPerformanceCounter() is a high resolution counter so short frames are still accurate
+		const EUi64 frameStartCounter = SDL_GetPerformanceCounter();
+		// Convert the counter difference into seconds since the last frame
+		double frameTime = static_cast<double>(frameStartCounter - m_lastCounter) / counterFrequency;
+		// Update the last counter to the current counter for the loop
+		m_lastCounter = frameStartCounter;
+
+		// Clamp long frames so a slow frame does not need even more ticks to catch up
+		if (frameTime > m_maxFrameTime) {
+			frameTime = m_maxFrameTime;
+		}
+
+		if (m_useFixedTimeStep) {
+			// Process all engine input functions once per frame
+			ProcessInput();
+
+			// Run as many fixed ticks as the time passed allows
+			m_accumulator += frameTime;
+			m_deltaTime = m_fixedDeltaTime;
+
+			EUi32 ticks = 0;
+			while (m_accumulator >= m_fixedDeltaTime && ticks < m_maxTicksPerFrame) {
+				PreLoop();
+
+				// Store the transforms before the tick so rendering can blend between them
+				StorePreviousTransforms();
+
+				// Process all engine tick functions
+				Tick();
+
+				PostLoop();
+
+				m_accumulator -= m_fixedDeltaTime;
+				++ticks;
+			}
+
+			// Drop any time that could not be caught up with so the game slows down instead of stalling
+			if (ticks >= m_maxTicksPerFrame) {
+				m_accumulator = 0.0;
+			}
+
+			// How far the render is between the last two ticks
+			m_renderAlpha = static_cast<float>(m_accumulator / m_fixedDeltaTime);
+
+			// Process all engine render functions
+			Render();
+		}
+		else {
+			m_deltaTime = frameTime;
+			m_renderAlpha = 1.0f;
+
+			// The order of these functions is important
+			// We must detect input, react with logic and then render based on logic
+			PreLoop();
+
+			// Process all engine input functions
+			ProcessInput();
+
+			// Process all engine tick functions
+			Tick();
+
+			// Process all engine render functions
+			Render();
+
+			PostLoop();
+		}
 
 		// Caps the frame rate
-		int frameDuration = 1000 / m_frameRate;
+		// If the frame finished faster than the frame rate allows, delay the rest of the frame
+		const double frameDuration = 1.0 / static_cast<double>(m_frameRate);
+		const double frameWorkTime = static_cast<double>(SDL_GetPerformanceCounter() - frameStartCounter) / counterFrequency;
 
-		if ((double)frameDuration > deltaMilli) {
-			frameDuration = int(deltaMilli);
+		if (frameWorkTime < frameDuration) {
+			SDL_Delay(static_cast<EUi32>((frameDuration - frameWorkTime) * 1000.0));
 		}
+	}
+}
 
-		// If the frame rate is greater than m_frameRate, delay the frame
-		SDL_Delay((EUi32)frameDuration);
+void EGameEngine::HeadlessLoop()
+{
+	// Number of performance counter ticks in a second
+	const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
 
-		// The order of these functions is important
-		// We must detect input, react with logic and then render based on logic
-		PreLoop();
+	// Every tick simulates the same amount of time, no matter how fast it runs
+	m_deltaTime = m_fixedDeltaTime;
+	m_renderAlpha = 1.0f;
+
+	EDebug::Log("Running headless for " + (m_frameBudget > 0 ? std::to_string(m_frameBudget) : EString("unlimited")) + " ticks");
+
+	const EUi64 startCounter = SDL_GetPerformanceCounter();
+	EUi64 ticks = 0;
 
-		// Process all engine input functions
-		ProcessInput();
+	while (!m_window->IsPendingClose() && (m_frameBudget == 0 || ticks < m_frameBudget)) {
+		// Collect the zones from the last tick
+		EPROFILE_END_FRAME();
+		EPROFILE_ZONE("Frame");
+
+		PreLoop();
 
-		// Process all engine tick functions
 		Tick();
 
-		// Process all engine render functions
-		Render();
-		
 		PostLoop();
+
+		++ticks;
+	}
+
+	// Log the game logic throughput
+	const double seconds = static_cast<double>(SDL_GetPerformanceCounter() - startCounter) / counterFrequency;
+	const double ticksPerSecond = seconds > 0.0 ? static_cast<double>(ticks) / seconds : 0.0;
+	const double msPerTick = ticks > 0 ? seconds * 1000.0 / static_cast<double>(ticks) : 0.0;
+
+	EDebug::Log("Headless ran " + std::to_string(ticks) + " ticks in " + std::to_string(seconds) + "s | "
+		+ std::to_string(ticksPerSecond) + " ticks/s | " + std::to_string(msPerTick) + " ms/tick | "
+		+ std::to_string(m_objectStore.GetObjects().size()) + " objects | "
+		+ std::to_string(m_objectPool.GetTotalAllocations()) + " pooled allocations", LT_SUCCESS);
+
+#if EPROFILING_ENABLED
+	EProfiler::EndFrame();
+	EProfiler::LogSummary();
+#endif
+}
+
+void EGameEngine::SetFixedTimeStep(bool enabled, double tickRate)
+{
+	m_useFixedTimeStep = enabled;
+
+	if (tickRate > 0.0) {
+		m_fixedDeltaTime = 1.0 / tickRate;
+	}
+
+	m_accumulator = 0.0;
+}
+
+void EGameEngine::StorePreviousTransforms()
+{
+	for (const auto& woRef : GetObjectsOfType<EWorldObject>()) {
+		woRef->StorePreviousTransform();
+	}
+
+	if (const auto& camRef = GetGraphicsEngine()->GetCamera().lock()) {
+		camRef->previousTransform = camRef->transform;
 	}
 }
 
 void EGameEngine::Cleanup()
 {
+	m_jobSystem = nullptr;
 	m_input = nullptr;
 	m_window = nullptr;
 	SDL_Quit();
@@ -277,6 +690,8 @@ void EGameEngine::Cleanup()
 
 void EGameEngine::Tick()
 {
+	EPROFILE_ZONE("Tick");
+
 	// Randomly change brightness if flag set (LEFT CTRL)
 	if (m_window->m_randomlyChangeBrightness) {
 		float randBrightness = GetRandomFloatRange(0.5f, 1.5f);
@@ -287,39 +702,122 @@ void EGameEngine::Tick()
 	if (m_window)
 		m_window->MoveCamera();
 
-	// Run through all EObjects in the game and run their ticks
-	for (const auto& eObjectRef : m_objectStack) {
-		eObjectRef->Tick(DeltaTimeF());
-
-		// Check if object is a world object, otherwise skip logic 
-		if (const auto& woRef = std::dynamic_pointer_cast<EWorldObject>(eObjectRef)) {
-			// Check if world object has collisions
-			if (woRef->HasCollisions()) {
-				// Loop through all objects to test against
-				for (const auto& otherObj : m_objectStack) {
-					// Test if the other object is also a world object
-					if (const auto& otherWoRef = std::dynamic_pointer_cast<EWorldObject>(otherObj)) {
-						// Skip colliding with self
-						if (woRef == otherWoRef)
-							continue;
-
-						// Check if other ref has collisions
-						if (!otherWoRef->HasCollisions())
-							continue;
-
-						// If all is good then test if their collisions are overlapping
-						woRef->TestCollision(otherWoRef);
-					}
-				}
+	const float deltaTime = DeltaTimeF();
+
+	// Fire the timers that expire this tick, including object lifetimes
+	{
+		EPROFILE_ZONE("Timers");
+		m_timers.Advance(m_deltaTime, m_objectStore);
+	}
+
+	// Tick every object
+	{
+		EPROFILE_ZONE("Object Tick");
+
+		// Run the parallel ticks across all workers
+		// Nothing else runs at the same time so they can read other objects safely
+		m_deferObjectChanges = true;
+		m_jobSystem->ParallelFor((EUi32)m_parallelTickObjects.size(), 64, [this, deltaTime](EUi32 begin, EUi32 end) {
+			EPROFILE_ZONE("Object Tick Chunk");
+			for (EUi32 i = begin; i < end; ++i) {
+				m_parallelTickObjects[i]->Tick(deltaTime);
 			}
+		});
+		m_deferObjectChanges = false;
+
+		// Run through all other EObjects in the game and run their ticks
+		for (EObject* eObject : m_serialTickObjects) {
+			eObject->Tick(deltaTime);
 		}
+	}
+
+	// Test world object collisions after every object has ticked
+	TestCollisions();
+
+	// Count the pooled objects allocated and reused this second
+	m_objectPool.UpdateStats(deltaTime);
+
+	// Post tick every object
+	{
+		EPROFILE_ZONE("Object Post Tick");
+
+		// Run the parallel post ticks across all workers
+		m_deferObjectChanges = true;
+		m_jobSystem->ParallelFor((EUi32)m_parallelTickObjects.size(), 64, [this, deltaTime](EUi32 begin, EUi32 end) {
+			EPROFILE_ZONE("Object Post Tick Chunk");
+			for (EUi32 i = begin; i < end; ++i) {
+				m_parallelTickObjects[i]->PostTick(deltaTime);
+			}
+		});
+		m_deferObjectChanges = false;
 
-		eObjectRef->PostTick(DeltaTimeF());
+		// Run through all other EObjects in the game and run their post ticks
+		for (EObject* eObject : m_serialTickObjects) {
+			eObject->PostTick(deltaTime);
+		}
+	}
+}
+
+void EGameEngine::TestCollisions()
+{
+	EPROFILE_ZONE("Collision");
+
+	// Rebuild the static grid only when static colliders spawn or are destroyed
+	if (m_staticBroadphaseDirty) {
+		m_staticBroadphase.Clear();
+
+		// The index in the static colliders is the static broadphase owner id
+		for (EUi32 i = 0; i < m_staticColliders.size(); ++i) {
+			for (const auto& colRef : m_staticColliders[i]->GetCollisions()) {
+				m_staticBroadphase.Insert(colRef->box, i);
+			}
+		}
+
+		m_staticBroadphase.Build();
+		m_staticBroadphaseDirty = false;
+	}
+
+	// Add the collisions of every moving world object into the broadphase
+	// The index in the dynamic colliders is the broadphase owner id
+	m_broadphase.Clear();
+	for (EUi32 i = 0; i < m_dynamicColliders.size(); ++i) {
+		for (const auto& colRef : m_dynamicColliders[i]->GetCollisions()) {
+			m_broadphase.Insert(colRef->box, i);
+		}
+	}
+
+	// Only test objects that share a cell
+	// Both objects test against each other to run both overlap events
+	for (const auto& [a, b] : m_broadphase.FindPairs()) {
+		m_dynamicColliders[a]->TestCollision(m_dynamicColliders[b]);
+		m_dynamicColliders[b]->TestCollision(m_dynamicColliders[a]);
+	}
+
+	// Test each moving object against the static colliders it shares a cell with
+	// Static colliders are never tested against each other
+	for (const auto& dynamicRef : m_dynamicColliders) {
+		m_staticQueryResults.clear();
+		for (const auto& colRef : dynamicRef->GetCollisions()) {
+			m_staticBroadphase.Query(colRef->box, m_staticQueryResults);
+		}
+
+		// Objects with more than one collision can find the same static collider twice
+		if (dynamicRef->GetCollisions().size() > 1) {
+			std::sort(m_staticQueryResults.begin(), m_staticQueryResults.end());
+			m_staticQueryResults.erase(std::unique(m_staticQueryResults.begin(), m_staticQueryResults.end()), m_staticQueryResults.end());
+		}
+
+		for (const EUi32 staticIndex : m_staticQueryResults) {
+			dynamicRef->TestCollision(m_staticColliders[staticIndex]);
+			m_staticColliders[staticIndex]->TestCollision(dynamicRef);
+		}
 	}
 }
 
 void EGameEngine::ProcessInput()
 {
+	EPROFILE_ZONE("Process Input");
+
 	if (!m_input)
 		return;
 
@@ -329,6 +827,8 @@ void EGameEngine::ProcessInput()
 
 void EGameEngine::Render()
 {
+	EPROFILE_ZONE("Render");
+
 	if (!m_window)
 		return;
 
@@ -338,12 +838,31 @@ void EGameEngine::Render()
 
 void EGameEngine::PreLoop()
 {
+	EPROFILE_ZONE("Pre Loop");
+
 	// Running through all objects to be spawned
 	// Run their start logic and add to game object stack
 	for (auto& eObjectRef : m_objectsToBeSpawned) {
 		eObjectRef->Start();
-		eObjectRef->RegisterInputs(m_input);
-		m_objectStack.push_back(std::move(eObjectRef));
+		if (m_input)
+			eObjectRef->RegisterInputs(m_input);
+		m_objectRegistry.Add(eObjectRef);
+		m_objectStore.Add(eObjectRef, eObjectRef->GetHandle());
+
+		// Start the lifetime set before the object spawned
+		if (eObjectRef->m_lifeTime > 0.0f)
+			SetLifeTime(eObjectRef.get(), eObjectRef->m_lifeTime);
+
+		// Only objects that need to tick are added to a tick list
+		// Objects that don't tick still post tick once so they can place their collisions
+		MoveToTickList(eObjectRef.get());
+		if (!eObjectRef->IsTickEnabled())
+			eObjectRef->PostTick(0.0f);
+
+		// Sort world objects with collisions into moving and static colliders
+		// Objects that add collisions later are sorted when the change is applied
+		if (const auto& woRef = std::dynamic_pointer_cast<EWorldObject>(eObjectRef))
+			MoveToColliderList(woRef);
 	}
 
 	m_objectsToBeSpawned.clear();
@@ -351,31 +870,73 @@ void EGameEngine::PreLoop()
 
 void EGameEngine::PostLoop()
 {
-	// Get stacks stack
-	TArray<TShared<ESLight>>& eLightStack = m_window->GetGraphicsEngine()->GetLights();
-	
+	EPROFILE_ZONE("Post Loop");
+
+	// Add the changes from the parallel tick first so their destroys run this loop
+	MergeCommandBuffers();
+
+	// Move objects that changed their tick settings or collisions before any are destroyed
+	ApplyTickListChanges();
+	ApplyColliderChanges();
+
+	// Objects removed from the stack this frame
+	TArray<EObject*> removedObjects;
+
 	// Loop through all objects pending destroy
-	// Remove their references from the object stack
+	// Remove their references from the object store
 	for (const auto& eObjectRef : m_objectsPendingDestroy) {
-		auto it = std::find(m_objectStack.begin(), m_objectStack.end(), eObjectRef);
+		// Swaps the last object into its place, skips objects already removed
+		if (!m_objectStore.Remove(eObjectRef->GetHandle())) {
+			// Objects destroyed before they spawned only hold a reserved handle
+			// Free the handle and never spawn them
+			if (!m_objectStore.Release(eObjectRef->GetHandle()))
+				continue;
+
+			std::erase(m_objectsToBeSpawned, eObjectRef);
+
+			if (eObjectRef->m_poolIndex != EObjectPool::noPool) {
+				m_objectPool.Release(eObjectRef, eObjectRef->m_poolIndex);
+			}
 
-		if (it == m_objectStack.end())
 			continue;
+		}
 
 		// Cleanup lights from the lights stack (otherwise they stay forever)
 		if (const auto& eLightObjectRef = std::dynamic_pointer_cast<ELightObject>(eObjectRef)) {
-			// Get the model
-			const auto& eLight = eLightObjectRef->GetPointLight();
+			m_window->GetGraphicsEngine()->RemoveLight(eLightObjectRef->GetPointLight().lock());
+		}
+
+		removedObjects.push_back(eObjectRef.get());
+		RemoveFromTickList(eObjectRef.get());
 
-			// Find the light objects light
-			auto lightIt = std::find(eLightStack.begin(), eLightStack.end(), eLight.lock());
+		// Removed from the collider lists with the other destroyed objects below
+		if (EWorldObject* worldObject = dynamic_cast<EWorldObject*>(eObjectRef.get()))
+			worldObject->m_colliderList = CL_NONE;
+		m_timers.Clear(eObjectRef->m_lifeTimeTimer);
 
-			// If it was found then erase it
-			if (lightIt != eLightStack.end())
-				eLightStack.erase(lightIt);
+		// Return pooled objects to their pool to be reused
+		if (eObjectRef->m_poolIndex != EObjectPool::noPool) {
+			m_objectPool.Release(eObjectRef, eObjectRef->m_poolIndex);
 		}
+	}
+
+	// Remove the objects from the type buckets
+	// This also sorts the removed objects so they can be searched
+	m_objectRegistry.Remove(removedObjects);
+
+	// Remove the objects from the collider lists
+	if (!removedObjects.empty()) {
+		const auto isRemoved = [&removedObjects](EObject* object) {
+			return std::binary_search(removedObjects.begin(), removedObjects.end(), object);
+		};
+		const auto isRemovedCollider = [&isRemoved](const TShared<EWorldObject>& woRef) {
+			return isRemoved(woRef.get());
+		};
+
+		std::erase_if(m_dynamicColliders, isRemovedCollider);
 
-		m_objectStack.erase(it);
+		if (std::erase_if(m_staticColliders, isRemovedCollider) > 0)
+			m_staticBroadphaseDirty = true;
 	}
 
 	// Make sure the clear the pending destroy array so no references remain
@@ -386,12 +947,12 @@ float EGameEngine::GetRandomFloatRange(float min, float max) const
 {
 	std::uniform_real_distribution<float> RandNum(min, max);
 
-	return RandNum(RandGenerator);
+	return RandNum(GetRandGenerator());
 }
 
 int EGameEngine::GetRandomIntRange(int min, int max) const
 {
 	std::uniform_int_distribution<int> RandNum(min, max);
 
-	return RandNum(RandGenerator);
+	return RandNum(GetRandGenerator());
 }
\ No newline at end of file
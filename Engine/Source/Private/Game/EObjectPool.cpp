@@ -0,0 +1,71 @@
+#include "Game/EObjectPool.h"
+#include "Game/GameObjects/EObject.h"
+
+EObjectPool::EObjectPool()
+{
+	m_allocationsThisSecond = 0;
+	m_reusesThisSecond = 0;
+	m_allocationsPerSecond = 0;
+	m_reusesPerSecond = 0;
+	m_totalAllocations = 0;
+	m_statsTimer = 0.0f;
+}
+
+void EObjectPool::Release(const TShared<EObject>& object, EUi32 poolIndex)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (poolIndex >= m_freeLists.size())
+		m_freeLists.resize(poolIndex + 1);
+
+	m_freeLists[poolIndex].push_back(object);
+}
+
+void EObjectPool::UpdateStats(float deltaTime)
+{
+	m_statsTimer += deltaTime;
+
+	if (m_statsTimer < 1.0f)
+		return;
+
+	const EUi32 lastAllocationsPerSecond = m_allocationsPerSecond;
+
+	m_allocationsPerSecond = m_allocationsThisSecond.exchange(0);
+	m_reusesPerSecond = m_reusesThisSecond.exchange(0);
+	m_statsTimer = 0.0f;
+
+	// Only log changes so a steady pool stays quiet
+	if (m_allocationsPerSecond != lastAllocationsPerSecond) {
+		EDebug::Log("Object pool: " + std::to_string(m_allocationsPerSecond) + " allocations/s | "
+			+ std::to_string(m_reusesPerSecond) + " reuses/s | "
+			+ std::to_string(GetFreeCount()) + " free | "
+			+ std::to_string(m_totalAllocations) + " total allocations");
+	}
+}
+
+EUi32 EObjectPool::GetFreeCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	EUi32 freeCount = 0;
+	for (const auto& freeList : m_freeLists) {
+		freeCount += (EUi32)freeList.size();
+	}
+
+	return freeCount;
+}
+
+TShared<EObject> EObjectPool::Take(EUi32 poolIndex)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (poolIndex >= m_freeLists.size() || m_freeLists[poolIndex].empty())
+		return nullptr;
+
+	TShared<EObject> object = std::move(m_freeLists[poolIndex].back());
+	m_freeLists[poolIndex].pop_back();
+
+	++m_reusesThisSecond;
+
+	return object;
+}
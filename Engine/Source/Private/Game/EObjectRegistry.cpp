@@ -0,0 +1,28 @@
+#include "Game/EObjectRegistry.h"
+#include "Game/GameObjects/EObject.h"
+
+void EObjectRegistry::Add(const TShared<EObject>& object)
+{
+	std::lock_guard<std::mutex> lock(m_bucketMutex);
+
+	for (const auto& bucket : m_buckets) {
+		if (bucket)
+			bucket->TryAdd(object);
+	}
+}
+
+void EObjectRegistry::Remove(TArray<EObject*>& removed)
+{
+	if (removed.empty())
+		return;
+
+	// Sort so each bucket can binary search the removed objects
+	std::sort(removed.begin(), removed.end());
+
+	std::lock_guard<std::mutex> lock(m_bucketMutex);
+
+	for (const auto& bucket : m_buckets) {
+		if (bucket)
+			bucket->Remove(removed);
+	}
+}
@@ -0,0 +1,91 @@
+#include "Game/EObjectStore.h"
+
+ESObjectHandle EObjectStore::Reserve(EObject* object)
+{
+	EUi32 index = 0;
+
+	// Reuse a free slot if there is one
+	if (!m_freeSlots.empty()) {
+		index = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else {
+		index = (EUi32)m_slots.size();
+
+		if (index > ESObjectHandle::indexMask) {
+			EDebug::Log("Object store is out of handles", LT_ERROR);
+			return {};
+		}
+
+		m_slots.emplace_back();
+	}
+
+	ESObjectSlot& slot = m_slots[index];
+	slot.object = object;
+	slot.denseIndex = notAdded;
+
+	return ESObjectHandle(index, slot.generation);
+}
+
+void EObjectStore::Add(const TShared<EObject>& object, ESObjectHandle handle)
+{
+	if (Get(handle) != object.get()) {
+		EDebug::Log("Object store tried to add an object with a stale handle", LT_ERROR);
+		return;
+	}
+
+	m_slots[handle.GetIndex()].denseIndex = (EUi32)m_objects.size();
+	m_objects.push_back(object);
+	m_denseToSlot.push_back(handle.GetIndex());
+}
+
+bool EObjectStore::Remove(ESObjectHandle handle)
+{
+	// Ignore stale handles and objects that are not added yet
+	if (!Get(handle))
+		return false;
+
+	ESObjectSlot& slot = m_slots[handle.GetIndex()];
+	if (slot.denseIndex == notAdded)
+		return false;
+
+	// Swap the last object into the removed objects place
+	const EUi32 denseIndex = slot.denseIndex;
+	const EUi32 lastIndex = (EUi32)m_objects.size() - 1;
+	if (denseIndex != lastIndex) {
+		m_objects[denseIndex] = std::move(m_objects[lastIndex]);
+		m_denseToSlot[denseIndex] = m_denseToSlot[lastIndex];
+		m_slots[m_denseToSlot[denseIndex]].denseIndex = denseIndex;
+	}
+
+	m_objects.pop_back();
+	m_denseToSlot.pop_back();
+
+	FreeSlot(handle.GetIndex());
+	return true;
+}
+
+bool EObjectStore::Release(ESObjectHandle handle)
+{
+	// Ignore stale handles and objects that have been added
+	if (!Get(handle) || m_slots[handle.GetIndex()].denseIndex != notAdded)
+		return false;
+
+	FreeSlot(handle.GetIndex());
+	return true;
+}
+
+void EObjectStore::FreeSlot(EUi32 index)
+{
+	// Free the slot, the new generation makes old handles stale
+	ESObjectSlot& slot = m_slots[index];
+	slot.object = nullptr;
+	slot.denseIndex = notAdded;
+	slot.generation = (slot.generation + 1) & (0xFFFFFFFF >> ESObjectHandle::indexBits);
+
+	// Skip generation 0 so a handle is never 0
+	if (slot.generation == 0)
+		slot.generation = 1;
+
+	m_freeSlots.push_back(index);
+}
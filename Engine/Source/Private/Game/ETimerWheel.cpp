@@ -0,0 +1,186 @@
+#include "Game/ETimerWheel.h"
+#include "Game/GameObjects/EObject.h"
+
+ETimerWheel::ETimerWheel(double resolution)
+{
+	m_resolution = resolution;
+	m_accumulator = 0.0;
+	m_currentStep = 0;
+	m_activeCount = 0;
+
+	m_slotHeads.assign(levelCount * slotCount, invalidIndex);
+}
+
+ESTimerHandle ETimerWheel::Add(double delay, const std::function<void()>& callback, bool repeat, ESObjectHandle owner)
+{
+	// Timers always fire on a later step, even with no delay
+	const EUi64 steps = std::max<EUi64>((EUi64)(std::max(delay, 0.0) / m_resolution + 0.5), 1);
+
+	EUi32 index = 0;
+
+	// Reuse a free timer if there is one
+	if (!m_freeTimers.empty()) {
+		index = m_freeTimers.back();
+		m_freeTimers.pop_back();
+	}
+	else {
+		index = (EUi32)m_timers.size();
+		m_timers.emplace_back();
+	}
+
+	ESTimer& timer = m_timers[index];
+	timer.callback = callback;
+	timer.expiryStep = m_currentStep + steps;
+	timer.intervalSteps = repeat ? steps : 0;
+	timer.owner = owner;
+
+	Schedule(index);
+	++m_activeCount;
+
+	return { index, timer.generation };
+}
+
+void ETimerWheel::Clear(ESTimerHandle handle)
+{
+	if (!IsActive(handle))
+		return;
+
+	Unlink(handle.index);
+	Free(handle.index);
+}
+
+void ETimerWheel::Advance(double seconds, const EObjectStore& objectStore)
+{
+	m_accumulator += seconds;
+
+	EUi64 steps = (EUi64)(m_accumulator / m_resolution);
+	m_accumulator -= (double)steps * m_resolution;
+
+	// Step through the slots while there are timers to fire
+	for (; steps > 0 && m_activeCount > 0; --steps) {
+		Step(objectStore);
+	}
+
+	// Nothing can fire with no timers so skip straight to the new step
+	m_currentStep += steps;
+}
+
+void ETimerWheel::Step(const EObjectStore& objectStore)
+{
+	++m_currentStep;
+
+	// Each time a level wraps, move the timers in the next slot of the level above down
+	for (EUi32 level = 1; level < levelCount; ++level) {
+		const EUi32 levelShift = slotBits * level;
+		if ((m_currentStep & ((1ULL << levelShift) - 1)) != 0)
+			break;
+
+		const EUi32 slot = level * slotCount + (EUi32)((m_currentStep >> levelShift) & slotMask);
+		while (m_slotHeads[slot] != invalidIndex) {
+			const EUi32 index = m_slotHeads[slot];
+			Unlink(index);
+			Schedule(index);
+		}
+	}
+
+	// Every timer left in the current bottom slot expires on this step
+	// Callbacks can't add timers to this slot as timers always fire on a later step
+	const EUi32 slot = (EUi32)(m_currentStep & slotMask);
+	while (m_slotHeads[slot] != invalidIndex) {
+		const EUi32 index = m_slotHeads[slot];
+		Unlink(index);
+		Fire(index, objectStore);
+	}
+}
+
+void ETimerWheel::Schedule(EUi32 index)
+{
+	ESTimer& timer = m_timers[index];
+
+	// Timers past the range of the wheel wait in the furthest slot and are scheduled again when it is reached
+	const EUi64 wheelRange = 1ULL << (slotBits * levelCount);
+	const EUi64 stepsLeft = timer.expiryStep - m_currentStep;
+	const EUi64 targetStep = stepsLeft < wheelRange ? timer.expiryStep : m_currentStep + wheelRange - 1;
+
+	// Find the lowest level that can hold the timer
+	EUi32 level = 0;
+	while (level < levelCount - 1 && (targetStep - m_currentStep) >= (1ULL << (slotBits * (level + 1)))) {
+		++level;
+	}
+
+	const EUi32 slot = level * slotCount + (EUi32)((targetStep >> (slotBits * level)) & slotMask);
+
+	// Add to the front of the slot list
+	timer.slot = slot;
+	timer.prev = invalidIndex;
+	timer.next = m_slotHeads[slot];
+	if (timer.next != invalidIndex)
+		m_timers[timer.next].prev = index;
+
+	m_slotHeads[slot] = index;
+}
+
+void ETimerWheel::Unlink(EUi32 index)
+{
+	ESTimer& timer = m_timers[index];
+	if (timer.slot == invalidIndex)
+		return;
+
+	if (timer.prev != invalidIndex)
+		m_timers[timer.prev].next = timer.next;
+	else
+		m_slotHeads[timer.slot] = timer.next;
+
+	if (timer.next != invalidIndex)
+		m_timers[timer.next].prev = timer.prev;
+
+	timer.slot = invalidIndex;
+	timer.next = invalidIndex;
+	timer.prev = invalidIndex;
+}
+
+void ETimerWheel::Free(EUi32 index)
+{
+	ESTimer& timer = m_timers[index];
+	timer.callback = nullptr;
+
+	// The new generation makes old handles stale, skip 0 so a handle is never empty
+	if (++timer.generation == 0)
+		timer.generation = 1;
+
+	m_freeTimers.push_back(index);
+	--m_activeCount;
+}
+
+void ETimerWheel::Fire(EUi32 index, const EObjectStore& objectStore)
+{
+	ESTimer& timer = m_timers[index];
+
+	// Drop timers whose owner has been destroyed
+	if (timer.owner.IsSet()) {
+		const EObject* owner = objectStore.Get(timer.owner);
+		if (!owner || owner->IsPendingDestroy()) {
+			Free(index);
+			return;
+		}
+	}
+
+	// Take the callback out as the callback can add timers and move the timer array
+	const EUi32 generation = timer.generation;
+	std::function<void()> callback = std::move(timer.callback);
+
+	// Schedule repeats before the callback so the callback can clear them
+	if (timer.intervalSteps > 0) {
+		timer.expiryStep += timer.intervalSteps;
+		Schedule(index);
+	}
+	else {
+		Free(index);
+	}
+
+	callback();
+
+	// Give the callback back to repeating timers that the callback did not clear
+	if (m_timers[index].generation == generation)
+		m_timers[index].callback = std::move(callback);
+}
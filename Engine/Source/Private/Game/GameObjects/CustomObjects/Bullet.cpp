@@ -5,14 +5,22 @@
 #define Super EWorldObject
 
 Bullet::Bullet(EECollisionType collisionType, glm::vec3 moveVector, float damage, float moveSpeed, float lifetime, glm::vec3 spawnPos, glm::vec3 spawnRot)
+{
+	Reset(collisionType, moveVector, damage, moveSpeed, lifetime, spawnPos, spawnRot);
+
+	// Bullets only move themselves so can tick on any thread
+	SetParallelTick(true);
+}
+
+void Bullet::Reset(EECollisionType collisionType, glm::vec3 moveVector, float damage, float moveSpeed, float lifetime, glm::vec3 spawnPos, glm::vec3 spawnRot)
 {
 	m_collisionType = collisionType;
 	m_moveVector = moveVector;
 	m_damage = damage;
 	m_moveSpeed = moveSpeed;
 	SetLifeTime(lifetime);
-	GetTransform().position = spawnPos;
-	GetTransform().rotation = spawnRot;
+	SetPosition(spawnPos);
+	SetRotation(spawnRot);
 }
 
 void Bullet::OnStart()
@@ -20,7 +28,15 @@ void Bullet::OnStart()
 	Super::OnStart();
 
 	// Scale floor
-	GetTransform().scale = glm::vec3(0.01f);
+	SetScale(glm::vec3(0.01f));
+
+	// Pooled bullets keep their model and collision, only update the collision
+	if (HasCollisions()) {
+		const auto& colRef = GetCollisions().front();
+		colRef->type = m_collisionType;
+		UpdateCollisions();
+		return;
+	}
 
 	// Add model
 	EString modelPath = "Models/Bullet/CubeBullet.fbx";
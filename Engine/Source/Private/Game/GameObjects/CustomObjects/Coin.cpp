@@ -7,7 +7,7 @@ void Coin::OnStart()
 	Super::OnStart();
 
 	// Scale mode
-	GetTransform().scale = glm::vec3(200.0f);
+	SetScale(glm::vec3(200.0f));
 
 	// Add model
 	EString modelPath = "Models/Coin/scene.gltf";
@@ -31,7 +31,7 @@ void Coin::OnTick(float deltaTime)
 	
 	// Rotate
 	float rotationSpeed = 60.0f;
-	GetTransform().rotation.y += deltaTime * rotationSpeed;
+	SetRotation(GetTransform().rotation + glm::vec3(0.0f, deltaTime * rotationSpeed, 0.0f));
 }
 
 void Coin::OnOverlap(const TShared<EWorldObject>& other, const TShared<ESCollision>& col, const TShared<ESCollision>& otherCol)
@@ -40,7 +40,7 @@ void Coin::OnOverlap(const TShared<EWorldObject>& other, const TShared<ESCollisi
 	
 	if (otherCol->type == EECollisionType::PLAYER) {
 		// Increment points
-		EGameEngine::GetGameEngine()->GetPoints() += m_points;
+		EGameEngine::GetGameEngine()->AddPoints(m_points);
 
 		// Display points
 		EString pointAmountText = toEString(EGameEngine::GetGameEngine()->GetPoints() * 1000);
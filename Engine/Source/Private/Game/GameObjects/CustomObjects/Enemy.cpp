@@ -5,10 +5,11 @@
 #include "Game/GameObjects/CustomObjects/Player.h"
 #include "Game/GameObjects/CustomObjects/Coin.h"
 #include "Graphics/EGraphicsEngine.h"
+#include "Debug/EProfiler.h"
 
 #define Super Character
 
-Enemy::Enemy(TWeak<Player> playerRef)
+Enemy::Enemy(TObjectHandle<Player> playerRef)
 {
 	m_playerRef = playerRef;
 	
@@ -16,6 +17,9 @@ Enemy::Enemy(TWeak<Player> playerRef)
 
 	m_weaponOffset = { 0.0f, 10.0f, 0.0f };
 	m_coinSpawnOffset = { 0.0f, 5.0f, 0.0f };
+
+	// Enemies only change themselves and their weapon so can tick on any thread
+	SetParallelTick(true);
 }
 
 void Enemy::OnStart()
@@ -28,10 +32,10 @@ void Enemy::OnStart()
 	}
 
 	// Adjust upward
-	GetTransform().position.y += 5.0f;
+	SetPosition(GetTransform().position + glm::vec3(0.0f, 5.0f, 0.0f));
 
 	// Scale enemy
-	GetTransform().scale = glm::vec3(15.0f);
+	SetScale(glm::vec3(15.0f));
 
 	// Add model
 	EString modelPath = "Models/Enemy/scene.gltf";
@@ -53,7 +57,7 @@ void Enemy::OnTick(float deltaTime)
 	Super::OnTick(deltaTime);
 	
 	// Move weapon to enemy
-	m_weapon->GetTransform().position = GetTransform().position + m_weaponOffset;
+	m_weapon->SetPosition(GetTransform().position + m_weaponOffset);
 }
 
 void Enemy::OnOverlap(const TShared<EWorldObject>& other, const TShared<ESCollision>& col, const TShared<ESCollision>& otherCol)
@@ -69,27 +73,27 @@ void Enemy::OnOverlap(const TShared<EWorldObject>& other, const TShared<ESCollis
 
 void Enemy::OnPostTick(float deltaTime)
 {
+	EPROFILE_ZONE("Enemy Aim");
+
 	Super::OnPostTick(deltaTime);
 	
 	// Look at player
-	if (const auto& player = m_playerRef.lock()) {
-		if (player) {
-			// Calculate target angle with atan2 from enemy and player positions
-			float targetAngle = glm::degrees(atan2(player->GetTransform().position.x - GetTransform().position.x,
-				player->GetTransform().position.z - GetTransform().position.z));
-
-			// Get the closest difference with mod
-			float angleDifference = fmod(targetAngle - GetTransform().rotation.y + 180.0f, 360.0f) - 180.0f;
-
-			// Add the angle difference and look at the player
-			GetTransform().rotation.y += angleDifference + 180.0f;
-
-			// Keep attempting to fire
-			glm::vec3 shootDirection = player->GetTransform().position - GetTransform().position;
-			shootDirection.y = 0.0f;
-			shootDirection = glm::normalize(shootDirection);
-			m_weapon->TryFire(EECollisionType::BULLET_ENEMY, shootDirection);
-		}
+	if (Player* player = m_playerRef.Get()) {
+		// Calculate target angle with atan2 from enemy and player positions
+		float targetAngle = glm::degrees(atan2(player->GetTransform().position.x - GetTransform().position.x,
+			player->GetTransform().position.z - GetTransform().position.z));
+
+		// Get the closest difference with mod
+		float angleDifference = fmod(targetAngle - GetTransform().rotation.y + 180.0f, 360.0f) - 180.0f;
+
+		// Add the angle difference and look at the player
+		SetRotation(GetTransform().rotation + glm::vec3(0.0f, angleDifference + 180.0f, 0.0f));
+
+		// Keep attempting to fire
+		glm::vec3 shootDirection = player->GetTransform().position - GetTransform().position;
+		shootDirection.y = 0.0f;
+		shootDirection = glm::normalize(shootDirection);
+		m_weapon->TryFire(EECollisionType::BULLET_ENEMY, shootDirection);
 	}
 }
 
@@ -101,7 +105,7 @@ void Enemy::OnTakeDamage(float damage)
 	if (m_health <= 0.0) {
 		// Spawn coin
 		if (const auto& coinRef = EGameEngine::GetGameEngine()->CreateObject<Coin>().lock()) {
-			coinRef->GetTransform().position = GetTransform().position + m_coinSpawnOffset;
+			coinRef->SetPosition(GetTransform().position + m_coinSpawnOffset);
 		}
 
 		// Spawn new enemy
@@ -112,7 +116,7 @@ void Enemy::OnTakeDamage(float damage)
 	}
 }
 
-void Enemy::SpawnEnemy(TWeak<Player> playerRef)
+void Enemy::SpawnEnemy(TObjectHandle<Player> playerRef)
 {
 	// Spawn a new enemy
 	if (const auto& newEnemy = EGameEngine::GetGameEngine()->CreateObject<Enemy>(playerRef).lock()) {
@@ -2,8 +2,12 @@
 
 void Floor::OnStart()
 {
+	// The floor never moves
+	SetTickEnabled(false);
+	SetStaticCollider(true);
+
 	// Scale floor
-	GetTransform().scale = glm::vec3(0.3f);
+	SetScale(glm::vec3(0.3f));
 
 	// Add model
 	EString modelPath = "Models/Grid/grid.fbx";
@@ -4,8 +4,11 @@
 
 void Grass::OnStart()
 {	
+	// Grass is only rendered
+	SetTickEnabled(false);
+
 	// Adjust scale
-	GetTransform().scale = glm::vec3(0.15f);
+	SetScale(glm::vec3(0.15f));
 	
 	// Add model
 	EString modelPath = "Models/Grass/Grass_green.fbx";
@@ -6,6 +6,10 @@ void InvisibleWalls::OnStart()
 {
 	Super::OnStart();
 
+	// The walls never move
+	SetTickEnabled(false);
+	SetStaticCollider(true);
+
 	// Add collisions for each direction
 	AddCollision({ glm::vec3(0.0f, 0.0f, 300.0f), glm::vec3(300.0f, 50.0f, 5.0f) }).lock()->type = EECollisionType::WALL;
 	AddCollision({ glm::vec3(0.0f, 0.0f, -300.0f), glm::vec3(300.0f, 50.0f, 5.0f) }).lock()->type = EECollisionType::WALL;
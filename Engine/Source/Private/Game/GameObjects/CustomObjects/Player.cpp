@@ -37,7 +37,7 @@ void Player::OnStart()
 	// If camera exists,
 	if (const auto& camRef = EGameEngine::GetGameEngine()->GetGraphicsEngine()->GetCamera().lock()) {
 		// Move to camera
-		GetTransform().position = camRef->transform.position;
+		SetPosition(camRef->transform.position);
 		// Set old position (for next loop)
 		m_oldPosition = GetTransform().position;
 	}
@@ -104,7 +104,7 @@ void Player::OnTick(float deltaTime)
 	if (const auto& camRef = EGameEngine::GetGameEngine()->GetGraphicsEngine()->GetCamera().lock()) {
 		if (camRef) {
 			// If weapon exists
-			GetTransform().position = camRef->transform.position;
+			SetPosition(camRef->transform.position);
 
 			// Fire weapon is holding left mouse
 			if (m_weapon && m_leftMouseHeld) {
@@ -134,7 +134,7 @@ void Player::OnPostTick(float deltaTime)
 			// Reset camera position to before collision
 			camRef->transform.position = m_oldPosition;
 			// Reset player position to before collision
-			GetTransform().position = m_oldPosition;
+			SetPosition(m_oldPosition);
 		}
 
 		// Update weapon position
@@ -148,8 +148,8 @@ void Player::OnPostTick(float deltaTime)
 				right * m_weaponOffset.x +
 				up * m_weaponOffset.y;
 
-			m_weapon->GetTransform().position = camRef->transform.position + rotatedWeaponOffset;
-			m_weapon->GetTransform().rotation = glm::vec3(camRef->transform.rotation.x, camRef->transform.rotation.y, 0.0f);
+			m_weapon->SetPosition(camRef->transform.position + rotatedWeaponOffset);
+			m_weapon->SetRotation(glm::vec3(camRef->transform.rotation.x, camRef->transform.rotation.y, 0.0f));
 		}
 
 		// Adjust light relative to player
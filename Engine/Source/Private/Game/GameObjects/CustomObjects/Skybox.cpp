@@ -6,9 +6,12 @@ void Skybox::OnStart()
 {
 	Super::OnStart();
 
+	// The skybox is only rendered
+	SetTickEnabled(false);
+
 	// Load model and textures
 	// Scale skybox
-	GetTransform().scale = glm::vec3(1.0f);
+	SetScale(glm::vec3(1.0f));
 
 	// Add model
 	EString modelPath = "Models/Skybox/SkyPano_Milkyway.fbx";
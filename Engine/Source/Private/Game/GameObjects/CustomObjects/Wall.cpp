@@ -7,8 +7,12 @@ void Wall::OnStart()
 {
 	Super::OnStart();
 
+	// Walls never move after they are placed
+	SetTickEnabled(false);
+	SetStaticCollider(true);
+
 	// Adjust scale
-	GetTransform().scale *= glm::vec3(0.1f, 0.07f, 0.1f);
+	SetScale(GetTransform().scale * glm::vec3(0.1f, 0.07f, 0.1f));
 
 	// Get random direction (L-R or U-D)
 	bool direction = EGameEngine::GetGameEngine()->GetRandomIntRange(0, 1) == 0;
@@ -19,7 +23,7 @@ void Wall::OnStart()
 	// Rotate wall if randomly set
 	if (direction) {
 		// Rotate transform
-		GetTransform().rotation.y += 90;
+		SetRotation(GetTransform().rotation + glm::vec3(0.0f, 90.0f, 0.0f));
 
 		float temp = wallCollisionSize.x;
 		wallCollisionSize.x = wallCollisionSize.z;
@@ -15,21 +15,26 @@ Weapon::Weapon(TWeak<Character> owner, bool addModel, float damage, float moveSp
 	m_attackCooldownTime = attackCooldownTime;
 	m_unlimitedAmmo = unlimitedAmmo;
 	
-	m_attackTimer = m_attackCooldownTime;
+	m_nextAttackTime = 0.0;
 
 	m_magazineSize = 16;
 	m_magazineAmmo = m_magazineSize;
 	m_reserveAmmo = 64;
+
+	// Weapons check their cooldown against the game time so never need to tick
+	SetTickEnabled(false);
 }
 
 void Weapon::TryFire(EECollisionType bulletCollisionType, glm::vec3 shootDirection)
 {
-	// If timer expired,
-	if (m_attackTimer <= 0.0f) {
+	const double gameTime = EGameEngine::GetGameEngine()->GetGameTime();
+
+	// If cooldown is over,
+	if (gameTime >= m_nextAttackTime) {
 		// Fire gun
 		Fire(bulletCollisionType, shootDirection);
-		// Reset timer
-		m_attackTimer = m_attackCooldownTime;
+		// Start cooldown
+		m_nextAttackTime = gameTime + m_attackCooldownTime;
 	}
 }
 
@@ -41,7 +46,8 @@ void Weapon::Fire(EECollisionType bulletCollisionType, glm::vec3 shootDirection)
 	glm::vec3 spawnRot = glm::vec3(-pitch, yaw, 0.0f);
 	float lifetime = 3.0f;
 
-	EGameEngine::GetGameEngine()->CreateObject<Bullet>(bulletCollisionType, glm::vec3(0, 0, 1), m_bulletDamage, m_bulletMoveSpeed, lifetime, spawnPos, spawnRot);
+	// Bullets are pooled as they are fired and destroyed constantly
+	EGameEngine::GetGameEngine()->CreatePooledObject<Bullet>(bulletCollisionType, glm::vec3(0, 0, 1), m_bulletDamage, m_bulletMoveSpeed, lifetime, spawnPos, spawnRot);
 }
 
 void Weapon::Reload()
@@ -52,12 +58,15 @@ void Weapon::Reload()
 void Weapon::OnStart()
 {
 	Super::OnStart();
+
+	// Start the first cooldown when the weapon spawns
+	m_nextAttackTime = EGameEngine::GetGameEngine()->GetGameTime() + m_attackCooldownTime;
 	
 	// Return if not adding model
 	if (!m_addModel) return;
 
 	// Scale gun
-	GetTransform().scale = glm::vec3(0.01f);
+	SetScale(glm::vec3(0.01f));
 
 	// Add model
 	EString modelPath = "Models/Gun/sg553_flipped.fbx";
@@ -70,12 +79,3 @@ void Weapon::OnStart()
 	};
 	auto model = LoadModel(modelPath, materials);
 }
-
-void Weapon::OnTick(float deltaTime)
-{
-	Super::OnTick(deltaTime);
-
-	// Decrement timer by delta time
-	if (m_attackTimer > 0.0f)
-		m_attackTimer -= deltaTime;
-}
@@ -8,7 +8,7 @@ void ELightObject::AddPointLight(glm::vec3 colour, float intensity, glm::vec3 po
 {
 	// Create point 
 	m_pointLight = EGameEngine::GetGameEngine()->GetGraphicsEngine()->CreatePointLight();
-	GetTransform().position = position;
+	SetPosition(position);
 
 	// Copy point light values
 	if (const auto& lightRef = m_pointLight.lock()) {
@@ -4,8 +4,12 @@ EObject::EObject()
 {
 	m_pendingDestroy = false;
 	m_lifeTime = 0.0f;
-	m_lifeTimeTimer = 0.0f;
 	m_doRender = true;
+	m_parallelTick = false;
+	m_tickEnabled = true;
+	m_tickList = TL_NONE;
+	m_tickIndex = 0;
+	m_poolIndex = EObjectPool::noPool;
 	
 	// EDebug::Log("EObject created");
 }
@@ -28,16 +32,6 @@ void EObject::RegisterInputs(const TShared<EInput>& m_input)
 void EObject::Tick(float deltaTime)
 {
 	OnTick(deltaTime);
-
-	if (m_lifeTime > 0.0f) {
-		// Count down the lifetime timer
-		m_lifeTimeTimer -= deltaTime;
-	}
-
-	// When the timer hits less than 0, destroy the object
-	if (m_lifeTimeTimer < 0.0f) {
-		Destroy();
-	}
 }
 
 void EObject::PostTick(float deltaTime)
@@ -45,6 +39,40 @@ void EObject::PostTick(float deltaTime)
 	OnPostTick(deltaTime);
 }
 
+void EObject::SetParallelTick(bool parallelTick)
+{
+	if (m_parallelTick == parallelTick)
+		return;
+
+	m_parallelTick = parallelTick;
+
+	// Move to the other tick list
+	EGameEngine::GetGameEngine()->UpdateTickList(this);
+}
+
+void EObject::SetTickEnabled(bool tickEnabled)
+{
+	if (m_tickEnabled == tickEnabled)
+		return;
+
+	m_tickEnabled = tickEnabled;
+
+	// Add to or remove from the tick lists
+	EGameEngine::GetGameEngine()->UpdateTickList(this);
+}
+
+void EObject::ResetForReuse()
+{
+	m_pendingDestroy = false;
+	m_lifeTime = 0.0f;
+	m_lifeTimeTimer = {};
+	m_doRender = true;
+	m_tickEnabled = true;
+
+	// Inputs were unbound when destroyed
+	m_inputUnbinds.clear();
+}
+
 void EObject::Destroy()
 {
 	m_pendingDestroy = true;
@@ -45,7 +45,7 @@ TWeak<ESprite> EScreenObject::GetSprite(const EString& texturePath)
 {
     // Return matching texture
     for (TShared<ESprite>& sprite : m_sprites) {
-        if (sprite->GetImportPath() == texturePath) { return sprite; }
+        if (sprite->GetTexturePath() == texturePath) { return sprite; }
     }
 
     return {};
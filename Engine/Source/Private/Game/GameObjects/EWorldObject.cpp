@@ -7,57 +7,20 @@
 
 TWeak<EModel> EWorldObject::ImportModel(const EString& modelPath, const TArray<ESMaterialSlot>& materials)
 {
-    // Import model
-    auto modelRef = EGameEngine::GetGameEngine()->GetGraphicsEngine()->ImportModel(modelPath);
-    if (!modelRef->HasMaterials()) return modelRef;
-
-    // Assign materials once per model
-    bool isDefaultTexture = modelRef->GetMaterials().at(0)->m_baseColourMap->GetImportPath() == "Textures/T_DefaultGrid.png";
-    if (isDefaultTexture) {
-        // Get static cache
-        static std::unordered_map<EString, TShared<ETexture>> textureCache;
-        static std::unordered_map<EString, TShared<ESMaterial>> materialCache;
-
-        // Apply materials
-        for (const auto& slot : materials) {
-            const ETexturePaths& paths = slot.desc.paths;
-
-            // Create texture if not in cache
-            if (!textureCache.count(paths.base)) {
-                auto texBase = TMakeShared<ETexture>();
-                texBase->LoadTexture(modelPath, paths.base);
-                textureCache[paths.base] = texBase;
-
-                if (!paths.normal.empty()) {
-                    auto texNormal = TMakeShared<ETexture>();
-                    texNormal->LoadTexture(modelPath, paths.normal);
-                    textureCache[paths.normal] = texNormal;
-                }
-
-                if (!paths.specular.empty()) {
-                    auto texSpecular = TMakeShared<ETexture>();
-                    texSpecular->LoadTexture(modelPath, paths.specular);
-                    textureCache[paths.specular] = texSpecular;
-                }
-            }
+    const auto& graphicsEngine = EGameEngine::GetGameEngine()->GetGraphicsEngine();
 
-            // Create material if not in cache
-            if (!materialCache.count(paths.base)) {
-                auto mat = EGameEngine::GetGameEngine()->CreateMaterial();
-                mat->m_baseColourMap = textureCache[paths.base];
-                if (!paths.normal.empty()) mat->m_normalMap = textureCache[paths.normal];
-                if (!paths.specular.empty()) mat->m_specularMap = textureCache[paths.specular];
-                mat->m_brightness = slot.desc.m_brightness;
-                mat->m_shininess = slot.desc.m_shininess;
-                mat->m_specularStrength = slot.desc.m_specularStrength;
-                mat->m_textureDepth = slot.desc.m_textureDepth;
-                materialCache[paths.base] = mat;
-            }
+    // Import model, it loads in the background
+    auto modelRef = graphicsEngine->ImportModel(modelPath);
 
-            // Add material to the model at each slot
-            for (int index : slot.slotIndices) {
-                modelRef->SetMaterialBySlot(index, materialCache[paths.base]);
-            }
+    // Materials come from the engine cache, so objects using the same description share one
+    // They apply when the model has loaded
+    EAssetCache& assetCache = graphicsEngine->GetAssetCache();
+    for (const auto& slot : materials) {
+        const auto& material = assetCache.GetMaterial(slot.desc);
+
+        // Add material to the model at each slot
+        for (int index : slot.slotIndices) {
+            modelRef->SetMaterialBySlot(index, material);
         }
     }
 
@@ -93,11 +56,26 @@ TWeak<ESCollision> EWorldObject::AddCollision(const ESBox& box, const bool& debu
     
     // Add the collision the the array
     m_objectCollisions.push_back(newCol);
+    m_collisionsDirty = true;
+
+    // Start testing the collisions if the object has already spawned
+    EGameEngine::GetGameEngine()->UpdateColliderList(this);
 
     // Return a weak version
     return newCol;
 }
 
+void EWorldObject::SetStaticCollider(bool staticCollider)
+{
+    if (m_staticCollider == staticCollider)
+        return;
+
+    m_staticCollider = staticCollider;
+
+    // Move to the other collider list
+    EGameEngine::GetGameEngine()->UpdateColliderList(this);
+}
+
 void EWorldObject::TestCollision(const TShared<EWorldObject>& other)
 {
     // Looping through this objects collisions
@@ -112,15 +90,57 @@ void EWorldObject::TestCollision(const TShared<EWorldObject>& other)
     }
 }
 
+void EWorldObject::SetPosition(const glm::vec3& position)
+{
+    m_transform.SetPosition(position);
+    m_collisionsDirty = true;
+}
+
+void EWorldObject::SetRotation(const glm::vec3& rotation)
+{
+    m_transform.SetRotation(rotation);
+    m_collisionsDirty = true;
+}
+
+void EWorldObject::SetScale(const glm::vec3& scale)
+{
+    m_transform.SetScale(scale);
+    m_collisionsDirty = true;
+}
+
+ESTransform EWorldObject::GetRenderTransform() const
+{
+    const float alpha = EGameEngine::GetGameEngine()->GetRenderAlpha();
+
+    // Nothing to blend when rendering on the latest tick
+    if (alpha >= 1.0f)
+        return m_transform;
+
+    return ESTransform::Lerp(m_previousTransform, m_transform, alpha);
+}
+
+glm::mat4 EWorldObject::GetRenderMatrix() const
+{
+    const float alpha = EGameEngine::GetGameEngine()->GetRenderAlpha();
+
+    // Objects that did not move last tick have nothing to blend
+    if (alpha >= 1.0f || m_previousTransform == m_transform)
+        return m_transform.GetMatrix();
+
+    return ESTransform::Lerp(m_previousTransform, m_transform, alpha).GetMatrix();
+}
+
 void EWorldObject::Rotate(float deltaTime, glm::vec3 rotation, glm::vec3 scale)
 {
-    GetTransform().rotation += rotation * scale * deltaTime;
+    glm::vec3 newRotation = m_transform.rotation + rotation * scale * deltaTime;
+
+    if (newRotation.x < -89.0f)
+        newRotation.x = -89.0f;
 
-    if (m_transform.rotation.x < -89.0f)
-        m_transform.rotation.x = -89.0f;
+    if (newRotation.x > 89.0f)
+        newRotation.x = 89.0f;
 
-    if (m_transform.rotation.x > 89.0f)
-        m_transform.rotation.x = 89.0f;
+    SetRotation(newRotation);
 }
 
 void EWorldObject::TranslateLocal(float deltaTime, glm::vec3 translation, glm::vec3 scale)
@@ -133,23 +153,39 @@ void EWorldObject::TranslateLocal(float deltaTime, glm::vec3 translation, glm::v
     if (glm::length(moveDir) != 0.0f)
         moveDir = glm::normalize(moveDir);
 
-    m_transform.position += moveDir * scale * deltaTime;
+    SetPosition(m_transform.position + moveDir * scale * deltaTime);
 }
 
 void EWorldObject::PlaceOnFloorRandomly(TShared<Floor> floor, float placementScale)
 {
     // Set the position to a random vertex position on the mesh
     if (auto model = floor->GetModel(0).lock()) {
-        GetTransform().position = floor->GetTransform().position + (model->GetMesh(0)->GetRandomVertexPosition() * placementScale);
+        // The vertices are needed now so wait for the floor to load
+        EGameEngine::GetGameEngine()->GetGraphicsEngine()->GetAssetManager().Finish(model);
+        if (!model->IsReady())
+            return;
+
+        SetPosition(floor->GetTransform().position + (model->GetMesh(0)->GetRandomVertexPosition() * placementScale));
     }
 }
 
-void EWorldObject::OnPostTick(float deltaTime)
+void EWorldObject::UpdateCollisions()
 {
-    Super::OnPostTick(deltaTime);
+    if (!m_collisionsDirty)
+        return;
 
-    // All collisions will follow the world object
+    // All collisions will follow the world object, the translation of the cached matrix is the world position
+    const glm::vec3 position = glm::vec3(m_transform.GetMatrix()[3]);
     for (const auto& colRef : m_objectCollisions) {
-        colRef->box.position = GetTransform().position;
+        colRef->MoveTo(position);
     }
+
+    m_collisionsDirty = false;
+}
+
+void EWorldObject::OnPostTick(float deltaTime)
+{
+    Super::OnPostTick(deltaTime);
+
+    UpdateCollisions();
 }
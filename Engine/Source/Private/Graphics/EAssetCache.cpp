@@ -0,0 +1,138 @@
+#include "Graphics/EAssetCache.h"
+#include "Graphics/EAssetManager.h"
+#include "Debug/EProfiler.h"
+
+// System Libs
+#include <cstring>
+
+EAssetCache::EAssetCache(EAssetManager& assetManager)
+	: m_assetManager(assetManager)
+{
+	m_frame = 0;
+	m_hits = m_misses = m_evictions = 0;
+}
+
+TShared<ETexture> EAssetCache::GetTexture(const EString& path, bool repeat, bool linear, EETextureType type)
+{
+	const EString key = MakeTextureKey(path, repeat, linear, type);
+
+	const auto it = m_textures.find(key);
+	if (it != m_textures.end()) {
+		++m_hits;
+		return it->second.asset;
+	}
+
+	++m_misses;
+
+	// Binds the placeholder texture until it loads
+	const auto& newTexture = TMakeShared<ETexture>();
+	newTexture->SetSource(path, path, repeat, linear, type);
+	m_assetManager.Load(newTexture);
+
+	TCacheEntry<ETexture>& entry = m_textures[key];
+	entry.asset = newTexture;
+	entry.lastUsedFrame = m_frame;
+
+	return newTexture;
+}
+
+TShared<ESMaterial> EAssetCache::GetMaterial(const ESMaterialDesc& desc)
+{
+	const EString key = MakeMaterialKey(desc);
+
+	const auto it = m_materials.find(key);
+	if (it != m_materials.end()) {
+		++m_hits;
+		return it->second.asset;
+	}
+
+	++m_misses;
+
+	// The maps come from the texture cache so materials sharing a map share the texture
+	const ETexturePaths& paths = desc.paths;
+	const auto& newMaterial = TMakeShared<ESMaterial>();
+	if (!paths.base.empty()) newMaterial->SetBaseColourMap(GetTexture(paths.base));
+	if (!paths.normal.empty()) newMaterial->SetNormalMap(GetTexture(paths.normal, true, true, TT_NORMAL));
+	if (!paths.specular.empty()) newMaterial->SetSpecularMap(GetTexture(paths.specular));
+	newMaterial->SetShininess(desc.m_shininess);
+	newMaterial->SetSpecularStrength(desc.m_specularStrength);
+	newMaterial->SetBrightness(desc.m_brightness);
+	newMaterial->SetTextureDepth(desc.m_textureDepth);
+
+	TCacheEntry<ESMaterial>& entry = m_materials[key];
+	entry.asset = newMaterial;
+	entry.lastUsedFrame = m_frame;
+
+	return newMaterial;
+}
+
+void EAssetCache::Update()
+{
+	EPROFILE_ZONE("Asset Cache");
+
+	++m_frame;
+
+	// Materials go first as they hold references to textures
+	Evict(m_materials);
+	Evict(m_textures);
+}
+
+ESAssetCacheStats EAssetCache::GetStats() const
+{
+	ESAssetCacheStats stats;
+	stats.hits = m_hits;
+	stats.misses = m_misses;
+	stats.evictions = m_evictions;
+	stats.textures = (EUi32)m_textures.size();
+	stats.materials = (EUi32)m_materials.size();
+
+	// Textures still loading have no GPU memory yet
+	for (const auto& [key, entry] : m_textures) {
+		if (entry.asset->IsReady())
+			stats.residentBytes += entry.asset->GetMemorySize();
+	}
+
+	return stats;
+}
+
+template<typename T>
+void EAssetCache::Evict(std::unordered_map<EString, TCacheEntry<T>>& entries)
+{
+	for (auto it = entries.begin(); it != entries.end();) {
+		TCacheEntry<T>& entry = it->second;
+
+		// Anything other than the cache holding the asset keeps it in use
+		if (entry.asset.use_count() > 1) {
+			entry.lastUsedFrame = m_frame;
+			++it;
+			continue;
+		}
+
+		if (m_frame - entry.lastUsedFrame >= evictionDelay) {
+			it = entries.erase(it);
+			++m_evictions;
+			continue;
+		}
+
+		++it;
+	}
+}
+
+EString EAssetCache::MakeTextureKey(const EString& path, bool repeat, bool linear, EETextureType type)
+{
+	return path + (repeat ? "|repeat" : "|clamp") + (linear ? "|linear" : "|nearest") + (type == TT_NORMAL ? "|normal" : "");
+}
+
+EString EAssetCache::MakeMaterialKey(const ESMaterialDesc& desc)
+{
+	// Use the exact bits of the floats so any difference makes a new material
+	const auto floatKey = [](float value) {
+		EUi32 bits = 0;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return "|" + std::to_string(bits);
+	};
+
+	return desc.paths.base + "|" + desc.paths.normal + "|" + desc.paths.specular
+		+ floatKey(desc.m_shininess) + floatKey(desc.m_specularStrength)
+		+ floatKey(desc.m_brightness) + floatKey(desc.m_textureDepth);
+}
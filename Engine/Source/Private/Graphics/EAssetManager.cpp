@@ -0,0 +1,92 @@
+#include "Graphics/EAssetManager.h"
+#include "Game/EGameEngine.h"
+#include "Debug/EProfiler.h"
+
+// System Libs
+#include <algorithm>
+#include <thread>
+
+EAssetManager::EAssetManager(bool synchronous)
+{
+	m_synchronous = synchronous;
+}
+
+void EAssetManager::Load(const TShared<EAsset>& asset)
+{
+	if (!asset)
+		return;
+
+	if (m_synchronous) {
+		asset->RunLoad();
+		asset->RunUpload();
+		return;
+	}
+
+	m_pending.push_back(asset);
+
+	// The task only holds a weak reference, if the asset is gone nothing needs loading
+	EGameEngine::GetGameEngine()->GetJobSystem()->Schedule([this, weakAsset = TWeak<EAsset>(asset)]() {
+		TShared<EAsset> loadingAsset = weakAsset.lock();
+		if (!loadingAsset)
+			return;
+
+		loadingAsset->RunLoad();
+
+		// This may be the last reference once the render thread has uploaded the asset
+		// Hand it back so the asset is destroyed on the render thread
+		std::lock_guard<std::mutex> lock(m_releasedMutex);
+		m_released.push_back(std::move(loadingAsset));
+	});
+}
+
+void EAssetManager::Update()
+{
+	EPROFILE_ZONE("Upload Assets");
+
+	// Take the references the load tasks handed back, assets nothing else uses are destroyed when this goes out of scope
+	TArray<TShared<EAsset>> released;
+	{
+		std::lock_guard<std::mutex> lock(m_releasedMutex);
+		released.swap(m_released);
+	}
+
+	size_t uploaded = 0;
+	size_t kept = 0;
+
+	for (size_t i = 0; i < m_pending.size(); ++i) {
+		const TShared<EAsset>& asset = m_pending[i];
+		const EEAssetState state = asset->GetLoadState();
+
+		// Upload in request order until the budget runs out
+		if (state == AS_LOADED && uploaded < uploadBudget) {
+			uploaded += asset->GetUploadSize();
+			asset->RunUpload();
+			continue;
+		}
+
+		// Drop assets that are done, failures were logged when they failed
+		if (state == AS_READY || state == AS_FAILED)
+			continue;
+
+		m_pending[kept++] = asset;
+	}
+
+	m_pending.resize(kept);
+}
+
+void EAssetManager::Finish(const TShared<EAsset>& asset)
+{
+	if (!asset)
+		return;
+
+	// Load it here if no worker has picked it up, otherwise wait for the worker
+	if (!asset->RunLoad()) {
+		while (asset->GetLoadState() == AS_LOADING) {
+			std::this_thread::yield();
+		}
+	}
+
+	asset->RunUpload();
+
+	m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), asset), m_pending.end());
+}
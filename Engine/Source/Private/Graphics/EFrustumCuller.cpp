@@ -0,0 +1,101 @@
+#include "Graphics/EFrustumCuller.h"
+#include "Debug/EProfiler.h"
+
+// System Libs
+#if defined(_M_X64) || defined(__SSE2__)
+#define ECULL_SIMD 1
+#include <xmmintrin.h>
+#else
+#define ECULL_SIMD 0
+#endif
+
+void EFrustumCuller::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_radius.clear();
+	m_count = 0;
+}
+
+EUi32 EFrustumCuller::Add(const glm::vec3& center, float radius)
+{
+	m_centerX.push_back(center.x);
+	m_centerY.push_back(center.y);
+	m_centerZ.push_back(center.z);
+	m_radius.push_back(radius);
+
+	return m_count++;
+}
+
+EUi32 EFrustumCuller::Cull(const ESFrustum& frustum)
+{
+	EPROFILE_ZONE("Frustum Cull");
+
+	// Pad the arrays so the last group of 4 can be read whole
+	const EUi32 paddedCount = (m_count + 3) & ~3U;
+	m_centerX.resize(paddedCount, 0.0f);
+	m_centerY.resize(paddedCount, 0.0f);
+	m_centerZ.resize(paddedCount, 0.0f);
+	m_radius.resize(paddedCount, 0.0f);
+	m_visible.assign(paddedCount, 0);
+
+	EUi32 visibleCount = 0;
+
+#if ECULL_SIMD
+	// Splat each plane once
+	__m128 planeX[ESFrustum::P_COUNT];
+	__m128 planeY[ESFrustum::P_COUNT];
+	__m128 planeZ[ESFrustum::P_COUNT];
+	__m128 planeW[ESFrustum::P_COUNT];
+	for (EUi32 p = 0; p < ESFrustum::P_COUNT; ++p) {
+		planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+		planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+		planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+		planeW[p] = _mm_set1_ps(frustum.planes[p].w);
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+
+	for (EUi32 i = 0; i < paddedCount; i += 4) {
+		const __m128 x = _mm_loadu_ps(&m_centerX[i]);
+		const __m128 y = _mm_loadu_ps(&m_centerY[i]);
+		const __m128 z = _mm_loadu_ps(&m_centerZ[i]);
+		const __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(&m_radius[i]));
+
+		// A sphere is inside while it is not fully behind any plane
+		__m128 inside = _mm_cmpeq_ps(zero, zero);
+		for (EUi32 p = 0; p < ESFrustum::P_COUNT; ++p) {
+			const __m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+				_mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+			inside = _mm_and_ps(inside, _mm_cmpgt_ps(distance, negRadius));
+		}
+
+		const int mask = _mm_movemask_ps(inside);
+		for (EUi32 lane = 0; lane < 4; ++lane) {
+			m_visible[i + lane] = (mask >> lane) & 1;
+		}
+	}
+
+	// Padding is never visible
+	for (EUi32 i = m_count; i < paddedCount; ++i) {
+		m_visible[i] = 0;
+	}
+
+	for (EUi32 i = 0; i < m_count; ++i) {
+		visibleCount += m_visible[i];
+	}
+#else
+	for (EUi32 i = 0; i < m_count; ++i) {
+		m_visible[i] = frustum.IntersectsSphere(
+			glm::vec3(m_centerX[i], m_centerY[i], m_centerZ[i]), m_radius[i]) ? 1 : 0;
+		visibleCount += m_visible[i];
+	}
+#endif
+
+	m_stats.objectsConsidered = m_count;
+	m_stats.objectsDrawn = visibleCount;
+
+	return visibleCount;
+}
@@ -10,9 +10,11 @@
 #include "Game/GameObjects/EWorldObject.h"
 #include "Game/GameObjects/EScreenObject.h"
 #include "Math/ESCollision.h"
+#include "Debug/EProfiler.h"
 
 // External Libs
 #include <algorithm>
+#include <chrono>
 #include <GLEW/glew.h>
 #include "SDL/SDL.h"
 #include "SDL/SDL_opengl.h"
@@ -40,6 +42,7 @@ const std::vector<EUi32> colMeshIData = {
 EGraphicsEngine::EGraphicsEngine()
 {
 	m_sdlGLContext = nullptr;
+	m_headless = false;
 	m_backgroundColor = EEBackgroundColor::BC_DEFAULT;
 }
 
@@ -95,6 +98,13 @@ bool EGraphicsEngine::InitEngine(SDL_Window* sdlWindow, const bool& vsync)
 	// Enable depth to be tested
 	glEnable(GL_DEPTH_TEST);
 
+	// Meshes with no vertex colour read this value so they stay white
+	glVertexAttrib4f(1, 1.0f, 1.0f, 1.0f, 1.0f);
+
+	// Time the shaders as compiling them is most of the startup
+	typedef std::chrono::high_resolution_clock EClock;
+	const auto shaderStart = EClock::now();
+
 	// Create the shader object
 	m_shader = TMakeShared<EShaderProgram>();
 
@@ -131,18 +141,31 @@ bool EGraphicsEngine::InitEngine(SDL_Window* sdlWindow, const bool& vsync)
 		return false;
 	}
 
+	const double shaderMs = std::chrono::duration<double, std::milli>(EClock::now() - shaderStart).count();
+	EDebug::Log("Shaders initialised in " + std::to_string(shaderMs) + " ms");
+
 	// Create the camera
 	m_camera = TMakeShared<ESCamera>();
 
+	// Create the light buffers
+	m_lightBuffer = TMakeUnique<ELightBuffer>();
+
 	// Create the default texture object
 	TShared<ETexture> defaultTexture = TMakeShared<ETexture>();
 	if (!defaultTexture->LoadTexture("Default Texure", "Textures/T_DefaultGrid.png")) {
 		EDebug::Log("Graphics engine default texture did not load.", LT_ERROR);
 	}
 
+	// Textures show the default texture until they have loaded
+	ETexture::SetPlaceholder(defaultTexture->GetID());
+
+	// Load assets on the workers and upload them a few at a time each frame
+	m_assetManager = TMakeUnique<EAssetManager>(false);
+	m_assetCache = TMakeUnique<EAssetCache>(*m_assetManager);
+
 	// Init a default material for all models
 	m_defaultMaterial = TMakeShared<ESMaterial>();
-	m_defaultMaterial->m_baseColourMap = defaultTexture;
+	m_defaultMaterial->SetBaseColourMap(defaultTexture);
 
 	// Log the success of the graphics engine initialisation
 	EDebug::Log("Successfully initialised Graphics Engine.", LT_SUCCESS);
@@ -179,8 +202,31 @@ bool EGraphicsEngine::InitEngine(SDL_Window* sdlWindow, const bool& vsync)
 	return true;
 }
 
+bool EGraphicsEngine::InitHeadless()
+{
+	m_headless = true;
+
+	// Create the camera
+	m_camera = TMakeShared<ESCamera>();
+
+	// Init a default material for all models, there are no textures without OpenGL
+	m_defaultMaterial = TMakeShared<ESMaterial>();
+
+	// Nothing renders so there is no frame to upload on, load assets straight away
+	m_assetManager = TMakeUnique<EAssetManager>(true);
+	m_assetCache = TMakeUnique<EAssetCache>(*m_assetManager);
+
+	EDebug::Log("Successfully initialised headless Graphics Engine.", LT_SUCCESS);
+
+	return true;
+}
+
 void EGraphicsEngine::Render(SDL_Window* sdlWindow)
 {
+	// Nothing to render to
+	if (m_headless)
+		return;
+
 	// Set a background color
 	ESBackgroundColorData backgroundColor = backgroundColorDataV.at(m_backgroundColor);
 	glClearColor(backgroundColor.m_color[0], backgroundColor.m_color[1], backgroundColor.m_color[2], 1.0f);
@@ -188,30 +234,91 @@ void EGraphicsEngine::Render(SDL_Window* sdlWindow)
 	// Clear the back buffer with a solid color
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+	// Upload the assets that finished loading since the last frame
+	m_assetManager->Update();
+
+	// Free the textures and materials nothing has used for a while
+	m_assetCache->Update();
+
+	// How far between the last two ticks to render objects
+	const float renderAlpha = EGameEngine::GetGameEngine()->GetRenderAlpha();
+
+	RenderWorld(renderAlpha);
+
+	RenderSprites();
+
+	RenderWires(renderAlpha);
+
+	// Swap the back buffer with the front buffer
+	SDL_GL_SwapWindow(sdlWindow);
+}
+
+void EGraphicsEngine::RenderWorld(float renderAlpha)
+{
+	EPROFILE_ZONE("Render World");
+
 	// ---------- NORMAL SHADER
 	// Activate shader
 	m_shader->Activate();
 
 	// Set the world transformations based on the camera
-	m_shader->SetWorldTransform(m_camera);
-
-	// Render
-	const auto& worldObjects = EGameEngine::GetGameEngine()->FindAllObjectsOfType<EWorldObject>();
-	for (const auto& weakObject : worldObjects) {
-		if (auto worldObjectRef = weakObject.lock()) {
-			// Skip objects set to not render
-			if (!worldObjectRef->GetDoRender()) { continue; }
-			// Check models exist			
-			if (worldObjectRef->GetModelCount() <= 0) { continue; }
-			// Render all models
-			for (EUi32 model = 0; model < worldObjectRef->GetModelCount(); ++model) {
-				if (auto modelRef = worldObjectRef->GetModel(model).lock()) {
-					modelRef->Render(worldObjectRef->GetTransform(), m_shader, m_lights);
-				}
+	m_shader->SetWorldTransform(m_camera, renderAlpha);
+
+	// Upload the lights once for every draw this frame
+	m_lightBuffer->Upload(m_lights);
+	m_shader->SetNumberOfLights((int)m_lightBuffer->GetDirLightCount(),
+		(int)m_lightBuffer->GetPointLightCount(), (int)m_lightBuffer->GetSpotLightCount());
+
+	// Pack a bounding sphere for every model so they can be culled together
+	m_frustumCuller.Clear();
+	m_cullCandidates.clear();
+
+	const auto& worldObjects = EGameEngine::GetGameEngine()->GetObjectsOfType<EWorldObject>();
+	for (const auto& worldObjectRef : worldObjects) {
+		// Skip objects set to not render
+		if (!worldObjectRef->GetDoRender()) { continue; }
+		// Check models exist			
+		if (worldObjectRef->GetModelCount() <= 0) { continue; }
+		// Blend the matrix once for all models
+		const glm::mat4 matObject = worldObjectRef->GetRenderMatrix();
+		// Add all models
+		for (EUi32 model = 0; model < worldObjectRef->GetModelCount(); ++model) {
+			if (auto modelRef = worldObjectRef->GetModel(model).lock()) {
+				const glm::mat4 matModel = modelRef->GetModelMatrix(matObject);
+				const ESBounds bounds = modelRef->GetBounds().Transformed(matModel);
+
+				// Models with no meshes have nothing to draw
+				if (!bounds.isValid) { continue; }
+
+				m_frustumCuller.Add(bounds.center, bounds.radius);
+				m_cullCandidates.push_back({ modelRef.get(), matModel });
 			}
 		}
 	}
 
+	// Reject the models outside the camera view before any GL work
+	m_frustumCuller.Cull(m_camera->GetFrustum(renderAlpha));
+
+	// Collect a draw for every mesh of the visible models
+	const ESTransform cameraTransform = m_camera->GetRenderTransform(renderAlpha);
+	m_renderQueue.Begin(cameraTransform.position, m_camera->farClip);
+
+	for (EUi32 i = 0; i < m_cullCandidates.size(); ++i) {
+		if (m_frustumCuller.IsVisible(i))
+			m_cullCandidates[i].model->AddToRenderQueue(m_renderQueue, m_cullCandidates[i].matModel, m_shader.get());
+	}
+
+	// Models are kept alive by their objects, don't hold them past the frame
+	m_cullCandidates.clear();
+
+	// Render sorted so state only changes when it has to
+	m_renderQueue.Submit(m_shader.get());
+}
+
+void EGraphicsEngine::RenderSprites()
+{
+	EPROFILE_ZONE("Render Sprites");
+
 	// ---------- SPRITE SHADER
 	// Activate shader
 	m_spriteShader->Activate();
@@ -222,28 +329,33 @@ void EGraphicsEngine::Render(SDL_Window* sdlWindow)
 	glDisable(GL_DEPTH_TEST);
 
 	// Sort screen objects by render order
-	auto screenObjects = EGameEngine::GetGameEngine()->FindAllObjectsOfType<EScreenObject>();
-	std::sort(screenObjects.begin(), screenObjects.end(),
-		[](const TWeak<EScreenObject>& a, const TWeak<EScreenObject>& b) {
-			const auto& aRef = a.lock();
-			const auto& bRef = b.lock();
-			if (!aRef || !bRef) return false;
-			return aRef->GetRenderOrder() < bRef->GetRenderOrder();
+	// Reuses the array from the last frame so it does not reallocate
+	const auto& screenObjects = EGameEngine::GetGameEngine()->GetObjectsOfType<EScreenObject>();
+	m_sortedScreenObjects.assign(screenObjects.begin(), screenObjects.end());
+	std::sort(m_sortedScreenObjects.begin(), m_sortedScreenObjects.end(),
+		[](const TShared<EScreenObject>& a, const TShared<EScreenObject>& b) {
+			return a->GetRenderOrder() < b->GetRenderOrder();
 	});
 
 	// Render
-	for (const auto& weakObject : screenObjects) {
-		if (auto screenObjectRef = weakObject.lock()) {
-			// Skip objects set to not render
-			if (!screenObjectRef->GetDoRender()) { continue; }
-			// Render all sprites
-			screenObjectRef->Render(m_spriteShader);
-		}
+	for (const auto& screenObjectRef : m_sortedScreenObjects) {
+		// Skip objects set to not render
+		if (!screenObjectRef->GetDoRender()) { continue; }
+		// Render all sprites
+		screenObjectRef->Render(m_spriteShader);
 	}
 
+	// Release the references until next frame
+	m_sortedScreenObjects.clear();
+
 	// Disable transparency blending
 	glDisable(GL_BLEND);
 	glEnable(GL_DEPTH_TEST);
+}
+
+void EGraphicsEngine::RenderWires(float renderAlpha)
+{
+	EPROFILE_ZONE("Render Wires");
 
 	// ---------- WIRE SHADER
 	if (m_collisions.size() > 0) {
@@ -251,22 +363,18 @@ void EGraphicsEngine::Render(SDL_Window* sdlWindow)
 		m_wireShader->Activate();
 
 		// Set the world transformations based on the camera
-		m_wireShader->SetWorldTransform(m_camera);
+		m_wireShader->SetWorldTransform(m_camera, renderAlpha);
 
 		// Render custom graphics
 		for (int i = m_collisions.size() - 1; i >= 0; --i) {
 			// Detecting if the reference still exists
 			if (const auto& colRef = m_collisions[i].lock()) {
-				// Convert position of collision into transform'
-				ESTransform transform;
-				transform.position = colRef->box.position;
-				transform.scale = colRef->box.halfSize;
-
 				// Set the colour of the collision
 				m_wireShader->SetWireColour(colRef->debugColour);
 
 				// Render if there is a reference
-				colRef->debugMesh->WireRender(m_wireShader, transform);
+				// The collision keeps its matrix up to date when it moves
+				colRef->debugMesh->WireRender(m_wireShader, colRef->debugMatrix);
 			}
 			else {
 				// Erase from the array if there is no reference
@@ -280,14 +388,12 @@ void EGraphicsEngine::Render(SDL_Window* sdlWindow)
 			}
 		}
 	}
-
-	// Swap the back buffer with the front buffer
-	SDL_GL_SwapWindow(sdlWindow);
 }
 
 TWeak<ESPointLight> EGraphicsEngine::CreatePointLight()
 {
 	const auto& newLight = TMakeShared<ESPointLight>();
+	newLight->engineIndex = (int)m_lights.size();
 	m_lights.push_back(newLight);
 	
 	return newLight;
@@ -296,6 +402,7 @@ TWeak<ESPointLight> EGraphicsEngine::CreatePointLight()
 TWeak<ESDirLight> EGraphicsEngine::CreateDirLight()
 {
 	const auto& newLight = TMakeShared<ESDirLight>();
+	newLight->engineIndex = (int)m_lights.size();
 	m_lights.push_back(newLight);
 
 	return newLight;
@@ -304,24 +411,52 @@ TWeak<ESDirLight> EGraphicsEngine::CreateDirLight()
 TWeak<ESSpotLight> EGraphicsEngine::CreateSpotLight()
 {
 	const auto& newLight = TMakeShared<ESSpotLight>();
+	newLight->engineIndex = (int)m_lights.size();
 	m_lights.push_back(newLight);
 
 	return newLight;
 }
 
+void EGraphicsEngine::RemoveLight(const TShared<ESLight>& light)
+{
+	if (!light)
+		return;
+
+	// Ignore lights that are not in the list
+	const int index = light->engineIndex;
+	if (index < 0 || index >= (int)m_lights.size() || m_lights[index] != light)
+		return;
+
+	light->engineIndex = -1;
+
+	// Swap it with the last light so the remove doesn't shift the list
+	if (index != (int)m_lights.size() - 1) {
+		m_lights[index] = m_lights.back();
+		m_lights[index]->engineIndex = index;
+	}
+
+	m_lights.pop_back();
+}
+
 TShared<EModel> EGraphicsEngine::ImportModel(const EString& path)
 {
 	// Get spawn id
 	size_t spawnID = m_models.size();
 
-	// Create model
+	// Create model, it has no meshes until it loads
 	const auto& newModel = TMakeShared<EModel>(spawnID, path);
-	newModel->ImportModel(path, m_defaultMaterial);
+	newModel->SetDefaultMaterial(m_defaultMaterial);
+	m_assetManager->Load(newModel);
 	m_models.push_back(newModel);
 
 	return newModel;
 }
 
+TShared<ETexture> EGraphicsEngine::LoadTexture(const EString& path, bool repeat, bool linear)
+{
+	return m_assetCache->GetTexture(path, repeat, linear);
+}
+
 TShared<ESMaterial> EGraphicsEngine::CreateMaterial()
 {
 	return TMakeShared<ESMaterial>();
@@ -330,17 +465,21 @@ TShared<ESMaterial> EGraphicsEngine::CreateMaterial()
 TShared<ESMaterial> EGraphicsEngine::CreateMaterialB(float brightness)
 {
 	TShared<ESMaterial> material = CreateMaterial();
-	material->m_brightness = brightness;
+	material->SetBrightness(brightness);
 	return material;
 }
 
 void EGraphicsEngine::CreateCollisionMesh(const TWeak<ESCollision>& col)
 {
+	// Collision meshes are only for debug rendering
+	if (m_headless)
+		return;
+
 	if (const auto& colRef = col.lock()) {
 		TShared<EMesh> newMesh = TMakeShared<EMesh>();
 
-		// Create a box of lines
-		newMesh->CreateMesh(colMeshVData, colMeshIData);
+		// Create a box of lines, only the positions are needed
+		newMesh->CreateMesh(colMeshVData, colMeshIData, ESVertexLayout());
 
 		// Store the shared mesh into the collision
 		colRef->debugMesh = newMesh;
@@ -352,12 +491,18 @@ void EGraphicsEngine::CreateCollisionMesh(const TWeak<ESCollision>& col)
 
 void EGraphicsEngine::AdjustTextureDepth(float delta)
 {
+	if (!m_shader)
+		return;
+
 	// Adjust the texture depth by the delta
 	m_shader->AdjustTextureDepth(delta);
 }
 
 void EGraphicsEngine::ResetTextureDepth()
 {
+	if (!m_shader)
+		return;
+
 	// Reset the texture depth
 	m_shader->ResetTextureDepth();
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "Graphics/ELightBuffer.h"
+#include "Graphics/ESLight.h"
+#include "Debug/EDebug.h"
+
+// External Libs
+#include <GLEW/glew.h>
+
+ELightBuffer::ELightBuffer()
+{
+	m_dirLightBuffer = m_pointLightBuffer = m_spotLightBuffer = 0;
+	m_dirLightCapacity = m_pointLightCapacity = m_spotLightCapacity = 0;
+	m_loggedLightLimit = false;
+
+	glGenBuffers(1, &m_dirLightBuffer);
+	glGenBuffers(1, &m_pointLightBuffer);
+	glGenBuffers(1, &m_spotLightBuffer);
+}
+
+ELightBuffer::~ELightBuffer()
+{
+	if (m_dirLightBuffer != 0)
+		glDeleteBuffers(1, &m_dirLightBuffer);
+	if (m_pointLightBuffer != 0)
+		glDeleteBuffers(1, &m_pointLightBuffer);
+	if (m_spotLightBuffer != 0)
+		glDeleteBuffers(1, &m_spotLightBuffer);
+}
+
+void ELightBuffer::Upload(const TArray<TShared<ESLight>>& lights)
+{
+	m_dirLights.clear();
+	m_pointLights.clear();
+	m_spotLights.clear();
+
+	bool overLimit = false;
+
+	// Pack the lights that are on by type
+	for (const auto& light : lights) {
+		if (!light->isLightOn)
+			continue;
+
+		// ----------- DIRECTIONAL LIGHTS
+		if (const auto& lightRef = std::dynamic_pointer_cast<ESDirLight>(light)) {
+			if (m_dirLights.size() >= maxLightsPerType) {
+				overLimit = true;
+				continue;
+			}
+
+			ESDirLightData& data = m_dirLights.emplace_back();
+			data.colour = lightRef->colour;
+			data.intensity = lightRef->intensity;
+			data.ambient = lightRef->ambient;
+			data.direction = lightRef->direction;
+			continue;
+		}
+
+		// ----------- POINT LIGHTS
+		if (const auto& lightRef = std::dynamic_pointer_cast<ESPointLight>(light)) {
+			if (m_pointLights.size() >= maxLightsPerType) {
+				overLimit = true;
+				continue;
+			}
+
+			ESPointLightData& data = m_pointLights.emplace_back();
+			data.colour = lightRef->colour;
+			data.intensity = lightRef->intensity;
+			data.position = lightRef->position;
+			data.linear = lightRef->linear;
+			data.quadratic = lightRef->quadratic;
+			continue;
+		}
+
+		// ----------- SPOT LIGHTS
+		if (const auto& lightRef = std::dynamic_pointer_cast<ESSpotLight>(light)) {
+			if (m_spotLights.size() >= maxLightsPerType) {
+				overLimit = true;
+				continue;
+			}
+
+			ESSpotLightData& data = m_spotLights.emplace_back();
+			data.colour = lightRef->colour;
+			data.intensity = lightRef->intensity;
+			data.position = lightRef->position;
+			data.linear = lightRef->linear;
+			data.direction = lightRef->direction;
+			data.quadratic = lightRef->quadratic;
+			data.innerCutOff = glm::cos(glm::radians(lightRef->innerCutOff));
+			data.outerCutOff = glm::cos(glm::radians(lightRef->outerCutOff));
+			continue;
+		}
+	}
+
+	if (overLimit && !m_loggedLightLimit) {
+		EDebug::Log("Too many lights, only " + std::to_string(maxLightsPerType) + " of each type are rendered", LT_WARNING);
+		m_loggedLightLimit = true;
+	}
+
+	UploadBuffer(m_dirLightBuffer, dirLightBinding, m_dirLightCapacity,
+		m_dirLights.data(), m_dirLights.size() * sizeof(ESDirLightData));
+	UploadBuffer(m_pointLightBuffer, pointLightBinding, m_pointLightCapacity,
+		m_pointLights.data(), m_pointLights.size() * sizeof(ESPointLightData));
+	UploadBuffer(m_spotLightBuffer, spotLightBinding, m_spotLightCapacity,
+		m_spotLights.data(), m_spotLights.size() * sizeof(ESSpotLightData));
+}
+
+void ELightBuffer::UploadBuffer(EUi32 buffer, EUi32 binding, size_t& capacity, const void* data, size_t size)
+{
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+
+	// Grow the buffer to fit, always keep some storage so the buffer can be bound with no lights
+	if (size > capacity || capacity == 0) {
+		capacity = std::max<size_t>(std::max(size, capacity * 2), 256);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)capacity, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	if (size > 0)
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, (GLsizeiptr)size, data);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
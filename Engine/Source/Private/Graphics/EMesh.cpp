@@ -7,10 +7,134 @@
 #include <GLEW/glew.h>
 #include <GLM/glm.hpp>
 #include <GLM/gtc/type_ptr.hpp>
+#include <GLM/gtc/packing.hpp>
+
+// System Libs
+#include <cstddef>
+#include <cstring>
+
+// Size of each attribute in a packed vertex
+static const EUi32 positionSize = sizeof(float) * 3;
+static const EUi32 colourSize = 4;
+static const EUi32 texCoordsSize = 4;
+static const EUi32 normalSize = 4;
+static const EUi32 tangentSize = 8;
+
+// Fold a unit vector onto an octahedron and unwrap it into a square from -1 to 1
+static glm::vec2 OctEncode(const glm::vec3& vector)
+{
+	const float length = glm::abs(vector.x) + glm::abs(vector.y) + glm::abs(vector.z);
+	if (length == 0.0f)
+		return glm::vec2(0.0f);
+
+	glm::vec2 encoded = glm::vec2(vector) / length;
+
+	// Fold the lower half over the diagonals
+	if (vector.z < 0.0f) {
+		const glm::vec2 signs = glm::vec2(encoded.x >= 0.0f ? 1.0f : -1.0f, encoded.y >= 0.0f ? 1.0f : -1.0f);
+		encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * signs;
+	}
+
+	return encoded;
+}
+
+// Write a value into a packed vertex
+template<typename T>
+static void WriteAttribute(EUi8* vertex, EUi32 offset, const T& value)
+{
+	std::memcpy(vertex + offset, &value, sizeof(T));
+}
+
+TArray<EUi8> ESVertexLayout::Pack(const std::vector<ESVertexData>& vertices) const
+{
+	const EUi32 stride = GetStride();
+	TArray<EUi8> packed(vertices.size() * stride, 0);
+
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const ESVertexData& source = vertices[i];
+		EUi8* vertex = packed.data() + i * stride;
+
+		std::memcpy(vertex, source.m_position, positionSize);
+
+		if (Has(VA_COLOUR)) {
+			WriteAttribute(vertex, GetOffset(VA_COLOUR),
+				glm::packUnorm4x8(glm::vec4(source.m_color[0], source.m_color[1], source.m_color[2], 1.0f)));
+		}
+
+		if (Has(VA_TEX_COORDS)) {
+			const glm::vec2 texCoords = glm::vec2(source.m_texCoords[0], source.m_texCoords[1]);
+			const EUi32 packedTexCoords = texCoordFormat == TF_UNORM16 ?
+				glm::packUnorm2x16(texCoords) : glm::packHalf2x16(texCoords);
+			WriteAttribute(vertex, GetOffset(VA_TEX_COORDS), packedTexCoords);
+		}
+
+		const glm::vec3 normal = glm::vec3(source.m_normal[0], source.m_normal[1], source.m_normal[2]);
+
+		if (Has(VA_NORMAL)) {
+			WriteAttribute(vertex, GetOffset(VA_NORMAL), glm::packSnorm2x16(OctEncode(normal)));
+		}
+
+		if (Has(VA_TANGENT)) {
+			const glm::vec3 tangent = glm::vec3(source.m_tangent[0], source.m_tangent[1], source.m_tangent[2]);
+			const glm::vec3 bitTangent = glm::vec3(source.m_bitTangent[0], source.m_bitTangent[1], source.m_bitTangent[2]);
+
+			// The bitangent is rebuilt from the normal and tangent, only its side is stored
+			const float bitTangentSign = glm::dot(glm::cross(normal, tangent), bitTangent) < 0.0f ? -1.0f : 1.0f;
+
+			const glm::vec2 encodedTangent = OctEncode(tangent);
+			WriteAttribute(vertex, GetOffset(VA_TANGENT),
+				glm::packSnorm4x16(glm::vec4(encodedTangent, bitTangentSign, 0.0f)));
+		}
+	}
+
+	return packed;
+}
+
+ESVertexLayout ESVertexLayout::Create(EUi8 attributes, const std::vector<ESVertexData>& vertices)
+{
+	ESVertexLayout layout;
+	layout.attributes = attributes;
+
+	// Unorm16 is more precise but can only hold coordinates from 0 to 1
+	layout.texCoordFormat = TF_UNORM16;
+	for (const ESVertexData& vertex : vertices) {
+		if (vertex.m_texCoords[0] < 0.0f || vertex.m_texCoords[0] > 1.0f ||
+			vertex.m_texCoords[1] < 0.0f || vertex.m_texCoords[1] > 1.0f) {
+			layout.texCoordFormat = TF_HALF;
+			break;
+		}
+	}
+
+	return layout;
+}
+
+EUi32 ESVertexLayout::GetStride() const
+{
+	return GetOffset(VA_TANGENT) + (Has(VA_TANGENT) ? tangentSize : 0);
+}
+
+EUi32 ESVertexLayout::GetOffset(EEVertexAttribute attribute) const
+{
+	// Attributes are stored in flag order after the position
+	EUi32 offset = positionSize;
+
+	if (attribute == VA_COLOUR) return offset;
+	offset += Has(VA_COLOUR) ? colourSize : 0;
+
+	if (attribute == VA_TEX_COORDS) return offset;
+	offset += Has(VA_TEX_COORDS) ? texCoordsSize : 0;
+
+	if (attribute == VA_NORMAL) return offset;
+	offset += Has(VA_NORMAL) ? normalSize : 0;
+
+	return offset;
+}
 
 EMesh::EMesh()
 {
 	m_vao = m_vbo = m_eao = 0;
+	m_instanceBuffer = 0;
+	m_indexType = GL_UNSIGNED_INT;
 	m_matTransform = glm::mat4(1.0f);
 	materialIndex = 0;
 }
@@ -25,12 +149,73 @@ EMesh::~EMesh()
 		glDeleteBuffers(1, &m_eao);
 }
 
-bool EMesh::CreateMesh(const std::vector<ESVertexData>& vertices, const std::vector<uint32_t>& indices)
+bool EMesh::CreateMesh(const std::vector<ESVertexData>& vertices, const std::vector<uint32_t>& indices,
+	const ESVertexLayout& layout)
 {
 	// Store the vertex data
 	m_vertices = vertices;
 	m_indices = indices;
+	m_layout = layout;
 
+	// Find the bounds of the vertex positions for culling
+	if (!m_vertices.empty()) {
+		m_bounds = ESBounds::FromPoints(reinterpret_cast<const glm::vec3*>(m_vertices[0].m_position),
+			m_vertices.size(), sizeof(ESVertexData));
+	}
+
+	// Headless runs have no OpenGL so keep the data on the CPU only
+	if (EGameEngine::GetGameEngine()->IsHeadless())
+		return true;
+
+	// Pack the vertices into the layout
+	const TArray<EUi8> packedVertices = m_layout.Pack(m_vertices);
+
+	// Meshes with fewer than 65536 vertices only need 16 bit indices, halving the index buffer
+	if (UsesShortIndices()) {
+		const TArray<EUi16> shortIndices(m_indices.begin(), m_indices.end());
+		return UploadBuffers(packedVertices.data(), packedVertices.size(),
+			shortIndices.data(), shortIndices.size() * sizeof(EUi16));
+	}
+
+	return UploadBuffers(packedVertices.data(), packedVertices.size(),
+		m_indices.data(), m_indices.size() * sizeof(uint32_t));
+}
+
+bool EMesh::CreatePackedMesh(const void* packedVertices, EUi32 vertexCount, const void* indices, EUi32 indexCount,
+	const ESVertexLayout& layout, const ESBounds& bounds)
+{
+	m_layout = layout;
+	m_bounds = bounds;
+
+	const EUi32 stride = m_layout.GetStride();
+	const EUi8* vertexBytes = static_cast<const EUi8*>(packedVertices);
+
+	// Only keep the positions on the CPU, they are always stored as floats at the start of each vertex
+	m_vertices.resize(vertexCount);
+	for (EUi32 i = 0; i < vertexCount; ++i) {
+		std::memcpy(m_vertices[i].m_position, vertexBytes + (size_t)i * stride, positionSize);
+	}
+
+	// Indices are 16 bit when the vertices fit
+	if (UsesShortIndices()) {
+		const EUi16* shortIndices = static_cast<const EUi16*>(indices);
+		m_indices.assign(shortIndices, shortIndices + indexCount);
+	}
+	else {
+		const uint32_t* longIndices = static_cast<const uint32_t*>(indices);
+		m_indices.assign(longIndices, longIndices + indexCount);
+	}
+
+	// Headless runs have no OpenGL so keep the data on the CPU only
+	if (EGameEngine::GetGameEngine()->IsHeadless())
+		return true;
+
+	return UploadBuffers(packedVertices, (size_t)vertexCount * stride,
+		indices, (size_t)indexCount * (UsesShortIndices() ? sizeof(EUi16) : sizeof(uint32_t)));
+}
+
+bool EMesh::UploadBuffers(const void* vertexData, size_t vertexSize, const void* indexData, size_t indexSize)
+{
 	// Create a vertex array object (VAO)
 	// Assign the ID for object to the m_vao variable
 	// Stores a reference to any VBO's attached to the VAO
@@ -80,102 +265,63 @@ bool EMesh::CreateMesh(const std::vector<ESVertexData>& vertices, const std::vec
 	// Start with the VBO which stores the vertex data
 	glBufferData(
 		GL_ARRAY_BUFFER, // Type of data stored
-		static_cast<GLsizeiptr>(m_vertices.size() * sizeof(ESVertexData)), // Size of each data in bytes
-		m_vertices.data(), // Memory location of data
+		static_cast<GLsizeiptr>(vertexSize), // Size of the data in bytes
+		vertexData, // Memory location of data
 		GL_STATIC_DRAW // Data will not be modified
 	);
 
 	// Set the data for the EAO
+	m_indexType = UsesShortIndices() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 	glBufferData(
 		GL_ELEMENT_ARRAY_BUFFER,
-		static_cast<GLsizeiptr>(m_indices.size() * sizeof(uint32_t)),
-		m_indices.data(),
+		static_cast<GLsizeiptr>(indexSize),
+		indexData,
 		GL_STATIC_DRAW
 	);
 
+	const GLsizei stride = static_cast<GLsizei>(m_layout.GetStride());
+
 	// Position
-	// Pass out the vertex data in seperate formats
+	// Always stored as full floats at the start of the vertex
 	glEnableVertexAttribArray(0);
-
-	// Set the position of that data to the 0 index of the attribute array
-	glVertexAttribPointer(
-		0, // Location to store the data in the attribute array
-		3, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		nullptr // How many numbers to skip in bytes
-	);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, nullptr);
 
 	// Color
-	// Pass out the vertex data in seperate formats
-	glEnableVertexAttribArray(1);
-
-	// Set the position of that data to the 1 index of the attribute array
-	glVertexAttribPointer(
-		1, // Location to store the data in the attribute array
-		3, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		(void*)(sizeof(float) * 3) // How many numbers to skip in bytes
-	);
+	// Shaders read white when the layout has no colour
+	if (m_layout.Has(VA_COLOUR)) {
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+			(void*)(size_t)m_layout.GetOffset(VA_COLOUR));
+	}
 
 	// Tex Coords
-	// Pass out the vertex data in seperate formats
-	glEnableVertexAttribArray(2);
-
-	// Set the position of that data to the 2 index of the attribute array
-	glVertexAttribPointer(
-		2, // Location to store the data in the attribute array
-		2, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		(void*)(sizeof(float) * 6) // How many numbers to skip in bytes
-	);
+	if (m_layout.Has(VA_TEX_COORDS)) {
+		glEnableVertexAttribArray(2);
+		if (m_layout.texCoordFormat == TF_UNORM16) {
+			glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride,
+				(void*)(size_t)m_layout.GetOffset(VA_TEX_COORDS));
+		}
+		else {
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+				(void*)(size_t)m_layout.GetOffset(VA_TEX_COORDS));
+		}
+	}
 
 	// Normals
-	// Pass out the vertex data in seperate formats
-	glEnableVertexAttribArray(3);
-
-	// Set the position of that data to the 3 index of the attribute array
-	glVertexAttribPointer(
-		3, // Location to store the data in the attribute array
-		3, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		(void*)(sizeof(float) * 8) // How many numbers to skip in bytes
-	);
+	// Octahedral so decoded in the vertex shader
+	if (m_layout.Has(VA_NORMAL)) {
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, stride,
+			(void*)(size_t)m_layout.GetOffset(VA_NORMAL));
+	}
 
 	// Tangents
-	// Pass out the tangent data in seperate formats
-	glEnableVertexAttribArray(4);
-
-	// Set the position of that data to the 4 index of the attribute array
-	glVertexAttribPointer(
-		4, // Location to store the data in the attribute array
-		3, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		(void*)(sizeof(float) * 11) // How many numbers to skip in bytes
-	);
-
-	// Bit Tangents
-	// Pass out the vertex data in seperate formats
-	glEnableVertexAttribArray(5);
-
-	// Set the position of that data to the 5 index of the attribute array
-	glVertexAttribPointer(
-		5, // Location to store the data in the attribute array
-		3, // How many numbers to pass into the attribute array index
-		GL_FLOAT, // The type of data to store
-		GL_FALSE, // Should we normalise the values (generally no)
-		sizeof(ESVertexData), // How big is each data array in a VertexData
-		(void*)(sizeof(float) * 14) // How many numbers to skip in bytes
-	);
+	// Octahedral with the bitangent sign, the bitangent is rebuilt in the vertex shader
+	if (m_layout.Has(VA_TANGENT)) {
+		glEnableVertexAttribArray(4);
+		glVertexAttribPointer(4, 4, GL_SHORT, GL_TRUE, stride,
+			(void*)(size_t)m_layout.GetOffset(VA_TANGENT));
+	}
 
 	// Common practice to clear the VAO from the GPU
 	glBindVertexArray(0);
@@ -183,10 +329,10 @@ bool EMesh::CreateMesh(const std::vector<ESVertexData>& vertices, const std::vec
 	return true;
 }
 
-void EMesh::WireRender(const TShared<EShaderProgram>& shader, const ESTransform& transform)
+void EMesh::WireRender(const TShared<EShaderProgram>& shader, const glm::mat4& matModel)
 {
-	// Update the transform of the mesh based on the model transform
-	shader->SetModelTransform(transform);
+	// Update the transform of the mesh based on the model matrix
+	shader->SetModelMatrix(matModel);
 
 	// Set the relative transform for the mesh in the shader
 	shader->SetMeshTransform(m_matTransform);
@@ -198,7 +344,7 @@ void EMesh::WireRender(const TShared<EShaderProgram>& shader, const ESTransform&
 	glDrawElements(
 		GL_LINE_LOOP, // Draw the mesh as lines
 		static_cast<GLsizei>(m_indices.size()), // How many vertices are there
-		GL_UNSIGNED_INT, // What type of data is the index array
+		m_indexType, // What type of data is the index array
 		nullptr // How many vertices are skipped
 	);
 
@@ -206,34 +352,49 @@ void EMesh::WireRender(const TShared<EShaderProgram>& shader, const ESTransform&
 	glBindVertexArray(0);
 }
 
-void EMesh::Render(const TShared<EShaderProgram>& shader, const ESTransform& transform,
-	const TArray<TShared<ESLight>>& lights, const TShared<ESMaterial>& material)
+void EMesh::Draw(EUi32 instanceCount, EUi32 firstInstance) const
 {
-	// Update the material in the shader
-	shader->SetMaterial(material);
-
-	// Update the transform of the mesh based on the model transform
-	shader->SetModelTransform(transform);
-	
-	// Set the relative transform for the mesh in the shader
-	shader->SetMeshTransform(m_matTransform);
-
-	// Set the lights in the shader for the mesh
-	shader->SetLights(lights);
-
-	// Binding this mesh as the active VAO
-	glBindVertexArray(m_vao);
-
-	// Render the VAO
-	glDrawElements(
+	// Render every instance of the VAO
+	glDrawElementsInstancedBaseInstance(
 		GL_TRIANGLES, // Draw the mesh as triangles
 		static_cast<GLsizei>(m_indices.size()), // How many vertices are there
-		GL_UNSIGNED_INT, // What type of data is the index array
-		nullptr // How many vertices are skipped
+		m_indexType, // What type of data is the index array
+		nullptr, // How many vertices are skipped
+		static_cast<GLsizei>(instanceCount), // How many instances to draw
+		firstInstance // First instance matrix in the instance buffer
 	);
+}
 
-	// Clear the VAO
-	glBindVertexArray(0);
+void EMesh::AttachInstanceBuffer(EUi32 buffer)
+{
+	if (m_instanceBuffer == buffer)
+		return;
+
+	// Instance matrices are read a column at a time and advance once per instance
+	if (m_instanceBuffer == 0) {
+		// World matrix, 4 vec4 columns
+		for (EUi32 column = 0; column < 4; ++column) {
+			const EUi32 location = instanceMatrixLocation + column;
+			glEnableVertexAttribArray(location);
+			glVertexAttribFormat(location, 4, GL_FLOAT, GL_FALSE,
+				offsetof(ESInstanceData, world) + sizeof(glm::vec4) * column);
+			glVertexAttribBinding(location, instanceBufferBinding);
+		}
+
+		// Normal matrix, 3 vec3 columns padded to vec4
+		for (EUi32 column = 0; column < 3; ++column) {
+			const EUi32 location = instanceNormalLocation + column;
+			glEnableVertexAttribArray(location);
+			glVertexAttribFormat(location, 3, GL_FLOAT, GL_FALSE,
+				offsetof(ESInstanceData, normalMatrix) + sizeof(glm::vec4) * column);
+			glVertexAttribBinding(location, instanceBufferBinding);
+		}
+
+		glVertexBindingDivisor(instanceBufferBinding, 1);
+	}
+
+	glBindVertexBuffer(instanceBufferBinding, buffer, 0, sizeof(ESInstanceData));
+	m_instanceBuffer = buffer;
 }
 
 const glm::vec3 EMesh::GetVertexPosition(unsigned int vertexIndex)
@@ -0,0 +1,268 @@
+#include "Graphics/EMeshOptimizer.h"
+#include "Graphics/EMesh.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// System Libs
+#include <algorithm>
+
+// Marks a vertex that has not been used yet
+static const EUi32 invalidVertex = 0xFFFFFFFF;
+
+ESMeshOptimizeStats EMeshOptimizer::Optimize(TArray<ESVertexData>& vertices, TArray<EUi32>& indices)
+{
+	ESMeshOptimizeStats stats;
+	stats.triangles = (EUi32)(indices.size() / 3);
+	stats.acmrBefore = ComputeACMR(indices, (EUi32)vertices.size());
+
+	if (stats.triangles == 0)
+		return stats;
+
+	TArray<EUi32> clusters;
+	OptimizeVertexCache(indices, (EUi32)vertices.size(), clusters);
+	OptimizeOverdraw(indices, vertices, clusters);
+	OptimizeVertexFetch(vertices, indices);
+
+	stats.acmrAfter = ComputeACMR(indices, (EUi32)vertices.size());
+	return stats;
+}
+
+float EMeshOptimizer::ComputeACMR(const TArray<EUi32>& indices, EUi32 vertexCount)
+{
+	const size_t triangles = indices.size() / 3;
+	if (triangles == 0)
+		return 0.0f;
+
+	// Miss count when each vertex last entered the FIFO cache
+	TArray<EUi32> cacheTimes(vertexCount, invalidVertex);
+	EUi32 misses = 0;
+
+	for (const EUi32 index : indices) {
+		// A vertex leaves a FIFO cache after cacheSize more misses
+		if (cacheTimes[index] == invalidVertex || misses - cacheTimes[index] >= cacheSize) {
+			cacheTimes[index] = misses;
+			++misses;
+		}
+	}
+
+	return (float)misses / (float)triangles;
+}
+
+void EMeshOptimizer::OptimizeVertexCache(TArray<EUi32>& indices, EUi32 vertexCount, TArray<EUi32>& clusters)
+{
+	// Tipsify, Sander, Nehab and Barczak 2007, Fast Triangle Reordering for Vertex Locality and Reduced Overdraw
+	clusters.clear();
+
+	const EUi32 triangleCount = (EUi32)(indices.size() / 3);
+	if (triangleCount == 0 || vertexCount == 0)
+		return;
+
+	// --------- ADJACENCY
+	// Triangles that use each vertex, stored as ranges in one array
+	TArray<EUi32> liveTriangles(vertexCount, 0);
+	for (const EUi32 index : indices) {
+		++liveTriangles[index];
+	}
+
+	TArray<EUi32> adjacencyOffsets(vertexCount + 1, 0);
+	for (EUi32 v = 0; v < vertexCount; ++v) {
+		adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+	}
+
+	TArray<EUi32> adjacency(indices.size());
+	TArray<EUi32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (EUi32 t = 0; t < triangleCount; ++t) {
+		for (EUi32 corner = 0; corner < 3; ++corner) {
+			adjacency[fill[indices[t * 3 + corner]]++] = t;
+		}
+	}
+
+	// --------- REORDER
+	TArray<EUi32> cacheTimes(vertexCount, 0);
+	TArray<bool> emitted(triangleCount, false);
+	TArray<EUi32> deadEnds;
+	TArray<EUi32> candidates;
+	TArray<EUi32> output;
+	output.reserve(indices.size());
+
+	// Timestamp starts past the cache so every vertex starts as a miss
+	EUi32 timestamp = cacheSize + 1;
+	EUi32 cursor = 0;
+	EUi32 fanning = 0;
+	bool newCluster = true;
+
+	while (fanning != invalidVertex) {
+		candidates.clear();
+
+		if (newCluster) {
+			clusters.push_back((EUi32)(output.size() / 3));
+			newCluster = false;
+		}
+
+		// Emit every triangle around the fanning vertex that is left
+		for (EUi32 a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; ++a) {
+			const EUi32 t = adjacency[a];
+			if (emitted[t])
+				continue;
+
+			for (EUi32 corner = 0; corner < 3; ++corner) {
+				const EUi32 v = indices[t * 3 + corner];
+				output.push_back(v);
+				deadEnds.push_back(v);
+				candidates.push_back(v);
+				--liveTriangles[v];
+
+				if (timestamp - cacheTimes[v] > cacheSize) {
+					cacheTimes[v] = timestamp;
+					++timestamp;
+				}
+			}
+
+			emitted[t] = true;
+		}
+
+		// Pick the candidate that will still be in the cache once all its triangles are emitted
+		// Vertices that are close to leaving the cache are preferred
+		EUi32 next = invalidVertex;
+		int bestPriority = -1;
+		for (const EUi32 v : candidates) {
+			if (liveTriangles[v] == 0)
+				continue;
+
+			int priority = 0;
+			if (timestamp - cacheTimes[v] + 2 * liveTriangles[v] <= cacheSize)
+				priority = (int)(timestamp - cacheTimes[v]);
+
+			if (priority > bestPriority) {
+				bestPriority = priority;
+				next = v;
+			}
+		}
+
+		// Dead end, go back to a recent vertex or the next vertex in order
+		if (next == invalidVertex) {
+			while (!deadEnds.empty()) {
+				const EUi32 v = deadEnds.back();
+				deadEnds.pop_back();
+				if (liveTriangles[v] > 0) {
+					next = v;
+					break;
+				}
+			}
+
+			if (next == invalidVertex) {
+				while (cursor < vertexCount && liveTriangles[cursor] == 0) {
+					++cursor;
+				}
+
+				if (cursor < vertexCount) {
+					next = cursor;
+					newCluster = true;
+				}
+			}
+		}
+
+		fanning = next;
+	}
+
+	indices.swap(output);
+}
+
+void EMeshOptimizer::OptimizeOverdraw(TArray<EUi32>& indices, const TArray<ESVertexData>& vertices, const TArray<EUi32>& clusters)
+{
+	const EUi32 triangleCount = (EUi32)(indices.size() / 3);
+	if (clusters.size() < 2)
+		return;
+
+	auto position = [&vertices](EUi32 index) {
+		return glm::vec3(vertices[index].m_position[0], vertices[index].m_position[1], vertices[index].m_position[2]);
+	};
+
+	// Area weighted center of the mesh
+	glm::vec3 meshCenter = glm::vec3(0.0f);
+	float meshArea = 0.0f;
+	for (EUi32 t = 0; t < triangleCount; ++t) {
+		const glm::vec3 a = position(indices[t * 3]);
+		const glm::vec3 b = position(indices[t * 3 + 1]);
+		const glm::vec3 c = position(indices[t * 3 + 2]);
+		const float area = glm::length(glm::cross(b - a, c - a));
+
+		meshCenter += (a + b + c) / 3.0f * area;
+		meshArea += area;
+	}
+
+	if (meshArea > 0.0f)
+		meshCenter /= meshArea;
+
+	// Score each cluster by how far its surface faces away from the mesh center
+	// Clusters facing out are more likely to be in front so they draw first
+	struct ESClusterSort {
+		EUi32 start;
+		EUi32 end;
+		float score;
+	};
+
+	TArray<ESClusterSort> sorted;
+	sorted.reserve(clusters.size());
+	for (size_t i = 0; i < clusters.size(); ++i) {
+		ESClusterSort cluster;
+		cluster.start = clusters[i];
+		cluster.end = i + 1 < clusters.size() ? clusters[i + 1] : triangleCount;
+
+		glm::vec3 center = glm::vec3(0.0f);
+		glm::vec3 normal = glm::vec3(0.0f);
+		float area = 0.0f;
+		for (EUi32 t = cluster.start; t < cluster.end; ++t) {
+			const glm::vec3 a = position(indices[t * 3]);
+			const glm::vec3 b = position(indices[t * 3 + 1]);
+			const glm::vec3 c = position(indices[t * 3 + 2]);
+			const glm::vec3 faceNormal = glm::cross(b - a, c - a);
+			const float faceArea = glm::length(faceNormal);
+
+			center += (a + b + c) / 3.0f * faceArea;
+			normal += faceNormal;
+			area += faceArea;
+		}
+
+		if (area > 0.0f)
+			center /= area;
+
+		const float normalLength = glm::length(normal);
+		cluster.score = normalLength > 0.0f ? glm::dot(center - meshCenter, normal / normalLength) : 0.0f;
+
+		sorted.push_back(cluster);
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(),
+		[](const ESClusterSort& a, const ESClusterSort& b) {
+			return a.score > b.score;
+	});
+
+	TArray<EUi32> output;
+	output.reserve(indices.size());
+	for (const ESClusterSort& cluster : sorted) {
+		output.insert(output.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+	}
+
+	indices.swap(output);
+}
+
+void EMeshOptimizer::OptimizeVertexFetch(TArray<ESVertexData>& vertices, TArray<EUi32>& indices)
+{
+	// New index of each vertex in the order it is first used
+	TArray<EUi32> remap(vertices.size(), invalidVertex);
+	TArray<ESVertexData> output;
+	output.reserve(vertices.size());
+
+	for (EUi32& index : indices) {
+		if (remap[index] == invalidVertex) {
+			remap[index] = (EUi32)output.size();
+			output.push_back(vertices[index]);
+		}
+
+		index = remap[index];
+	}
+
+	vertices.swap(output);
+}
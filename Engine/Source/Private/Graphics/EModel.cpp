@@ -1,6 +1,9 @@
 #include "Graphics/EModel.h"
 #include "Graphics/ESMaterial.h"
 #include "Graphics/ETexture.h"
+#include "Graphics/ERenderQueue.h"
+#include "Graphics/ESCookedMesh.h"
+#include "IO/EMappedFile.h"
 
 // External Libss
 #include <ASSIMP/Importer.hpp>
@@ -8,11 +11,18 @@
 #include <ASSIMP/postprocess.h>
 #include <ASSIMP/mesh.h>
 
+// System Libs
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+const EUi32 EModel::importFlags = aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices;
+
 EModel::EModel(unsigned int spawnID, EString path)
 {
 	m_spawnID = spawnID;
 	m_path = path;
-	m_offset.scale = glm::vec3(0.0f);
 }
 
 EModel::~EModel()
@@ -21,6 +31,139 @@ EModel::~EModel()
 }
 
 void EModel::ImportModel(const EString& filePath, const TShared<ESMaterial>& defaultMaterial)
+{
+	m_path = filePath;
+	m_defaultMaterial = defaultMaterial;
+
+	// Load and upload straight away
+	RunLoad();
+	RunUpload();
+}
+
+glm::mat4 EModel::GetModelMatrix(const glm::mat4& matObject) const
+{
+	// Most models have no offset so use the object matrix as is
+	if (m_offset == ESTransform())
+		return matObject;
+
+	return matObject * m_offset.GetMatrix();
+}
+
+void EModel::AddToRenderQueue(ERenderQueue& queue, const glm::mat4& matModel, EShaderProgram* shader)
+{
+	// Every mesh shares the model matrix
+	ESDrawPacket packet;
+	packet.shader = shader;
+	packet.model = matModel;
+
+	for (const auto& mesh : m_meshStack) {
+		packet.mesh = mesh.get();
+		packet.material = m_materialStack[mesh->materialIndex].get();
+		queue.Add(packet);
+	}
+}
+
+void EModel::SetMaterialBySlot(unsigned int slot, const TShared<ESMaterial>& material)
+{
+	// The slots aren't known until the model has loaded so keep the material until then
+	if (!IsReady()) {
+		if (slot >= m_materialStack.size())
+			m_materialStack.resize(slot + 1);
+
+		m_materialStack[slot] = material;
+		return;
+	}
+
+	// Ensure that the material slot exists
+	if (slot >= m_materialStack.size()) {
+		EDebug::Log("No material slot exists at index: " + std::to_string(slot), LT_WARNING);
+		return;
+	}
+
+	// Change the material if it does exist
+	m_materialStack[slot] = material;
+}
+
+bool EModel::LoadData()
+{
+	const EString cookedPath = m_path + cookedMeshExtension;
+
+	// Use the cooked model if it was cooked from this version of the source
+	m_importData = TMakeUnique<ESModelImportData>();
+	if (LoadCookedModel(cookedPath, m_path))
+		return true;
+
+	m_importData = TMakeUnique<ESModelImportData>();
+	if (!ImportSourceModel(m_path)) {
+		m_importData = nullptr;
+		return false;
+	}
+
+	// Cook the model so the next launch skips ASSIMP
+	SaveCookedModel(cookedPath, m_path);
+	return true;
+}
+
+bool EModel::UploadData()
+{
+	for (const ESMeshImportData& meshData : m_importData->meshes) {
+		auto eMesh = TMakeUnique<EMesh>();
+
+		// Test if the mesh failed to create
+		if (!eMesh->CreatePackedMesh(meshData.vertexData, meshData.vertexCount,
+			meshData.indexData, meshData.indexCount, meshData.layout, meshData.bounds)) {
+			EDebug::Log("Mesh failed to upload for model: " + m_path, LT_ERROR);
+			m_meshStack.clear();
+			m_importData = nullptr;
+			return false;
+		}
+
+		eMesh->materialIndex = meshData.materialIndex;
+		eMesh->SetRelativeTransform(meshData.relativeTransform);
+		m_meshStack.push_back(std::move(eMesh));
+	}
+
+	// Combine the mesh bounds in model space for culling
+	for (const auto& mesh : m_meshStack) {
+		m_bounds.Merge(mesh->GetBounds().Transformed(mesh->GetRelativeTransform()));
+	}
+
+	// Materials set before the model loaded are kept if their slot exists
+	for (size_t slot = m_importData->materialCount; slot < m_materialStack.size(); ++slot) {
+		if (m_materialStack[slot])
+			EDebug::Log("No material slot exists at index: " + std::to_string(slot), LT_WARNING);
+	}
+
+	// Set the material stack size to the amount of materials on the model
+	m_materialStack.resize(m_importData->materialCount);
+
+	// Set the remaining materials to the default material
+	for (auto& materialRef : m_materialStack) {
+		if (!materialRef)
+			materialRef = m_defaultMaterial;
+	}
+
+	// Frees the decoded meshes and unmaps the cooked file
+	m_importData = nullptr;
+
+	// Log the success of the model
+	//EDebug::Log("Model successfully imported with (" + std::to_string(m_meshStack.size()) + ") meshes: " + 
+	//	m_path, LT_SUCCESS);
+
+	return true;
+}
+
+size_t EModel::GetUploadSize() const
+{
+	size_t size = 0;
+	for (const ESMeshImportData& meshData : m_importData->meshes) {
+		size += meshData.GetVertexSize() + meshData.GetIndexSize();
+	}
+
+	return size;
+}
+
+bool EModel::ImportSourceModel(const EString& filePath)
 {
 	// Create an ASSIMP model importer
 	Assimp::Importer importer;
@@ -29,7 +172,8 @@ void EModel::ImportModel(const EString& filePath, const TShared<ESMaterial>& def
 	// Add post processing flag triangulate to make sure the model is triangles
 	// Can add a processing flag here to remove bones
 	// Added a flag to calculate the tangent space and get the tangent and bitTangent for normal maps
-	const auto scene = importer.ReadFile(filePath, aiProcess_Triangulate | aiProcess_CalcTangentSpace);
+	// Join identical vertices so triangles share vertices and the vertex cache can reuse them
+	const auto scene = importer.ReadFile(filePath, importFlags);
 
 	// Check if the import failed in any way
 	// !scene is checking if the object was null
@@ -38,7 +182,7 @@ void EModel::ImportModel(const EString& filePath, const TShared<ESMaterial>& def
 	if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
 		EDebug::Log("Error importing model from - " + filePath + ": " + importer.GetErrorString(),
 			LT_ERROR);
-		return;
+		return false;
 	}
 
 	// Update the scene matrix to start at x0, y0, z0
@@ -55,39 +199,145 @@ void EModel::ImportModel(const EString& filePath, const TShared<ESMaterial>& def
 	// Find all the meshes in the scene and fail in any of them fail
 	if (!FindAndImportMeshes(*scene->mRootNode, *scene, sceneTransform, &meshesCreated)) {
 		EDebug::Log("Model failed to convert ASSIMP scene: " + filePath, LT_ERROR);
-		return;
+		return false;
 	}
 
-	// Set the material stack size to the amount of materials on the model
-	m_materialStack.resize(scene->mNumMaterials);
-
-	// Set all materials to the default material
-	for (auto& materialRef : m_materialStack) {
-		materialRef = defaultMaterial;
+	// Report how much the vertex cache optimisation helped
+	if (m_optimizeStats.triangles > 0) {
+		EDebug::Log("Optimised model " + filePath + ": " + std::to_string(m_optimizeStats.triangles) + " triangles, ACMR "
+			+ std::to_string(m_optimizeStats.acmrBefore) + " -> " + std::to_string(m_optimizeStats.acmrAfter));
 	}
 
-	// Log the success of the model
-	//EDebug::Log("Model successfully imported with (" + std::to_string(meshesCreated) + ") meshes: " + 
-	//	filePath, LT_SUCCESS);
+	m_importData->materialCount = scene->mNumMaterials;
+	return true;
 }
 
-void EModel::Render(const ESTransform& transform, const TShared<EShaderProgram>& shader, const TArray<TShared<ESLight>>& lights)
+bool EModel::LoadCookedModel(const EString& cookedPath, const EString& sourcePath)
 {
-	for (const auto& mesh : m_meshStack) {
-		mesh->Render(shader, transform + m_offset, lights, m_materialStack[mesh->materialIndex]);
+	EMappedFile& file = m_importData->cookedFile;
+	if (!file.Open(cookedPath))
+		return false;
+
+	const EUi8* data = file.GetData();
+	const size_t size = file.GetSize();
+
+	// Check the file was cooked by this version of the engine from the current source
+	ESCookedModelHeader header;
+	if (size < sizeof(header))
+		return false;
+
+	std::memcpy(&header, data, sizeof(header));
+	if (header.magic != cookedMeshMagic || header.version != cookedMeshVersion || header.importFlags != importFlags)
+		return false;
+
+	if (!header.source.Matches(sourcePath))
+		return false;
+
+	if (sizeof(header) + (EUi64)header.meshCount * sizeof(ESCookedMeshEntry) > size) {
+		EDebug::Log("Cooked model is truncated, importing the source instead: " + cookedPath, LT_WARNING);
+		return false;
 	}
+
+	m_importData->meshes.resize(header.meshCount);
+	for (EUi32 i = 0; i < header.meshCount; ++i) {
+		ESCookedMeshEntry entry;
+		std::memcpy(&entry, data + sizeof(header) + i * sizeof(ESCookedMeshEntry), sizeof(entry));
+
+		ESMeshImportData& meshData = m_importData->meshes[i];
+		meshData.layout.attributes = entry.attributes;
+		meshData.layout.texCoordFormat = (EETexCoordFormat)entry.texCoordFormat;
+		meshData.bounds.center = entry.boundsCenter;
+		meshData.bounds.halfSize = entry.boundsHalfSize;
+		meshData.bounds.radius = entry.boundsRadius;
+		meshData.bounds.isValid = entry.boundsValid != 0;
+		meshData.relativeTransform = entry.relativeTransform;
+		meshData.materialIndex = entry.materialIndex;
+		meshData.vertexCount = entry.vertexCount;
+		meshData.indexCount = entry.indexCount;
+
+		// Don't read past the end of the file
+		if (entry.vertexOffset + meshData.GetVertexSize() > size || entry.indexOffset + meshData.GetIndexSize() > size) {
+			EDebug::Log("Cooked model is truncated, importing the source instead: " + cookedPath, LT_WARNING);
+			return false;
+		}
+
+		// The mapped data goes straight to the GPU
+		meshData.vertexData = data + entry.vertexOffset;
+		meshData.indexData = data + entry.indexOffset;
+	}
+
+	m_importData->materialCount = header.materialCount;
+	return true;
 }
 
-void EModel::SetMaterialBySlot(unsigned int slot, const TShared<ESMaterial>& material)
+void EModel::SaveCookedModel(const EString& cookedPath, const EString& sourcePath) const
 {
-	// Ensure that the material slot exists
-	if (slot >= m_materialStack.size()) {
-		EDebug::Log("No material slot exists at index: " + std::to_string(slot), LT_WARNING);
+	ESCookedModelHeader header = {};
+	header.magic = cookedMeshMagic;
+	header.version = cookedMeshVersion;
+	header.importFlags = importFlags;
+	header.meshCount = (EUi32)m_importData->meshes.size();
+	header.materialCount = m_importData->materialCount;
+
+	if (!ESFileStamp::FromFile(sourcePath, header.source))
 		return;
+
+	// Build the whole file in memory so it is written in one go
+	TArray<EUi8> fileData(sizeof(header) + m_importData->meshes.size() * sizeof(ESCookedMeshEntry), 0);
+	std::memcpy(fileData.data(), &header, sizeof(header));
+
+	// Add a block of data at the next aligned offset
+	auto appendBlock = [&fileData](const void* block, size_t blockSize) {
+		const EUi64 offset = (fileData.size() + cookedDataAlignment - 1) & ~(cookedDataAlignment - 1);
+		fileData.resize(offset + blockSize, 0);
+		std::memcpy(fileData.data() + offset, block, blockSize);
+		return offset;
+	};
+
+	for (size_t i = 0; i < m_importData->meshes.size(); ++i) {
+		const ESMeshImportData& meshData = m_importData->meshes[i];
+
+		ESCookedMeshEntry entry = {};
+		entry.relativeTransform = meshData.relativeTransform;
+		entry.boundsCenter = meshData.bounds.center;
+		entry.boundsRadius = meshData.bounds.radius;
+		entry.boundsHalfSize = meshData.bounds.halfSize;
+		entry.boundsValid = meshData.bounds.isValid ? 1 : 0;
+		entry.materialIndex = meshData.materialIndex;
+		entry.attributes = meshData.layout.attributes;
+		entry.texCoordFormat = meshData.layout.texCoordFormat;
+		entry.vertexCount = meshData.vertexCount;
+		entry.indexCount = meshData.indexCount;
+
+		// The data is already in the same format as the GPU
+		entry.vertexOffset = appendBlock(meshData.vertexData, meshData.GetVertexSize());
+		entry.indexOffset = appendBlock(meshData.indexData, meshData.GetIndexSize());
+
+		std::memcpy(fileData.data() + sizeof(header) + i * sizeof(ESCookedMeshEntry), &entry, sizeof(entry));
 	}
 
-	// Change the material if it does exist
-	m_materialStack[slot] = material;
+	// Write to a temporary file first so a failed write never leaves a broken cooked model
+	// Named by thread as two workers can import the same model at once
+	const EString tempPath = cookedPath + "." + toEString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(fileData.data()), (std::streamsize)fileData.size());
+
+		if (!file) {
+			EDebug::Log("Failed to write cooked model: " + cookedPath, LT_WARNING);
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(tempPath, error);
+			return;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, cookedPath, error);
+	if (error) {
+		EDebug::Log("Failed to write cooked model: " + cookedPath + ": " + error.message(), LT_WARNING);
+		std::filesystem::remove(tempPath, error);
+	}
 }
 
 bool EModel::FindAndImportMeshes(const aiNode& node, const aiScene& scene,
@@ -113,10 +363,10 @@ bool EModel::FindAndImportMeshes(const aiNode& node, const aiScene& scene,
 			vertex.m_position[2] = aMesh->mVertices[j].z;
 
 			// If there are vertex colours then update
-			if (aMesh->HasVertexColors(j)) {
-				vertex.m_color[0] = aMesh->mColors[j]->r;
-				vertex.m_color[1] = aMesh->mColors[j]->g;
-				vertex.m_color[2] = aMesh->mColors[j]->b;
+			if (aMesh->HasVertexColors(0)) {
+				vertex.m_color[0] = aMesh->mColors[0][j].r;
+				vertex.m_color[1] = aMesh->mColors[0][j].g;
+				vertex.m_color[2] = aMesh->mColors[0][j].b;
 			}
 
 			// Set the texture coordinates
@@ -129,19 +379,23 @@ bool EModel::FindAndImportMeshes(const aiNode& node, const aiScene& scene,
 			}	
 
 			// Set the normals for the model
-			vertex.m_normal[0] = aMesh->mNormals[j].x;
-			vertex.m_normal[1] = aMesh->mNormals[j].y;
-			vertex.m_normal[2] = aMesh->mNormals[j].z;
+			if (aMesh->HasNormals()) {
+				vertex.m_normal[0] = aMesh->mNormals[j].x;
+				vertex.m_normal[1] = aMesh->mNormals[j].y;
+				vertex.m_normal[2] = aMesh->mNormals[j].z;
+			}
 
-			// Set the tangents for the model
-			vertex.m_tangent[0] = aMesh->mTangents[j].x;
-			vertex.m_tangent[1] = aMesh->mTangents[j].y;
-			vertex.m_tangent[2] = aMesh->mTangents[j].z;
+			if (aMesh->HasTangentsAndBitangents()) {
+				// Set the tangents for the model
+				vertex.m_tangent[0] = aMesh->mTangents[j].x;
+				vertex.m_tangent[1] = aMesh->mTangents[j].y;
+				vertex.m_tangent[2] = aMesh->mTangents[j].z;
 
-			// Set the bitTangents for the model
-			vertex.m_bitTangent[0] = aMesh->mBitangents[j].x;
-			vertex.m_bitTangent[1] = aMesh->mBitangents[j].y;
-			vertex.m_bitTangent[2] = aMesh->mBitangents[j].z;
+				// Set the bitTangents for the model
+				vertex.m_bitTangent[0] = aMesh->mBitangents[j].x;
+				vertex.m_bitTangent[1] = aMesh->mBitangents[j].y;
+				vertex.m_bitTangent[2] = aMesh->mBitangents[j].z;
+			}
 
 			// Add the data into out vertex array
 			meshVertices.push_back(vertex);
@@ -166,17 +420,52 @@ bool EModel::FindAndImportMeshes(const aiNode& node, const aiScene& scene,
 			}
 		}
 
-		// Create the mesh object
-		auto eMesh = TMakeUnique<EMesh>();
+		// Reorder the triangles and vertices for the GPU caches
+		const ESMeshOptimizeStats meshStats = EMeshOptimizer::Optimize(meshVertices, meshIndicies);
+
+		// Combine into one ACMR for the model, weighted by triangles
+		const float totalTriangles = (float)(m_optimizeStats.triangles + meshStats.triangles);
+		if (totalTriangles > 0.0f) {
+			m_optimizeStats.acmrBefore = (m_optimizeStats.acmrBefore * m_optimizeStats.triangles
+				+ meshStats.acmrBefore * meshStats.triangles) / totalTriangles;
+			m_optimizeStats.acmrAfter = (m_optimizeStats.acmrAfter * m_optimizeStats.triangles
+				+ meshStats.acmrAfter * meshStats.triangles) / totalTriangles;
+			m_optimizeStats.triangles += meshStats.triangles;
+		}
 
-		// Test if the mesh failed to create
-		if (!eMesh->CreateMesh(meshVertices, meshIndicies)) {
-			EDebug::Log("Mesh failed to convert from aMesh to eMesh", LT_ERROR);
-			return false;
+		// Only store the attributes the mesh has on the GPU
+		EUi8 attributes = 0;
+		if (aMesh->HasVertexColors(0)) attributes |= VA_COLOUR;
+		if (aMesh->HasTextureCoords(0)) attributes |= VA_TEX_COORDS;
+		if (aMesh->HasNormals()) attributes |= VA_NORMAL;
+		if (aMesh->HasTangentsAndBitangents()) attributes |= VA_TANGENT;
+
+		ESMeshImportData meshData;
+		meshData.layout = ESVertexLayout::Create(attributes, meshVertices);
+		meshData.vertexCount = (EUi32)meshVertices.size();
+		meshData.indexCount = (EUi32)meshIndicies.size();
+
+		// Find the bounds of the vertex positions for culling
+		meshData.bounds = ESBounds::FromPoints(reinterpret_cast<const glm::vec3*>(meshVertices[0].m_position),
+			meshVertices.size(), sizeof(ESVertexData));
+
+		// Pack the vertices and indices into the format the GPU reads
+		meshData.ownedVertices = meshData.layout.Pack(meshVertices);
+		if (meshData.UsesShortIndices()) {
+			const TArray<EUi16> shortIndices(meshIndicies.begin(), meshIndicies.end());
+			meshData.ownedIndices.resize(shortIndices.size() * sizeof(EUi16));
+			std::memcpy(meshData.ownedIndices.data(), shortIndices.data(), meshData.ownedIndices.size());
 		}
+		else {
+			meshData.ownedIndices.resize(meshIndicies.size() * sizeof(EUi32));
+			std::memcpy(meshData.ownedIndices.data(), meshIndicies.data(), meshData.ownedIndices.size());
+		}
+
+		meshData.vertexData = meshData.ownedVertices.data();
+		meshData.indexData = meshData.ownedIndices.data();
 
 		// Get the material index from the ASSIMP mesh and set our index to the same
-		eMesh->materialIndex = aMesh->mMaterialIndex;
+		meshData.materialIndex = aMesh->mMaterialIndex;
 
 		// Set the relative transformation for the mesh
 		aiMatrix4x4 relTransform = parentTransform * node.mTransformation;
@@ -198,10 +487,10 @@ bool EModel::FindAndImportMeshes(const aiNode& node, const aiScene& scene,
 		matTransform[2][3] = relTransform.d3; matTransform[3][3] = relTransform.d4;
 
 		// Update the relative transform on the mesh
-		eMesh->SetRelativeTransform(matTransform);
+		meshData.relativeTransform = matTransform;
 
-		// Add the new mesh to the mesh stack
-		m_meshStack.push_back(std::move(eMesh));
+		// Add the new mesh to the import data, moving keeps the packed data in place
+		m_importData->meshes.push_back(std::move(meshData));
 
 		// Count the meshes created
 		++(*meshesCreated);
@@ -0,0 +1,179 @@
+#include "Graphics/ERenderQueue.h"
+#include "Graphics/EMesh.h"
+#include "Graphics/ESMaterial.h"
+#include "Graphics/ETexture.h"
+#include "Graphics/EShaderProgram.h"
+#include "Debug/EProfiler.h"
+
+// External Libs
+#include <GLEW/glew.h>
+
+// System Libs
+#include <algorithm>
+
+ERenderQueue::~ERenderQueue()
+{
+	if (m_instanceBuffer != 0)
+		glDeleteBuffers(1, &m_instanceBuffer);
+}
+
+void ERenderQueue::Begin(const glm::vec3& viewPosition, float farClip)
+{
+	m_packets.clear();
+	m_entries.clear();
+
+	m_viewPosition = viewPosition;
+	m_farClip = std::max(farClip, 0.0001f);
+}
+
+void ERenderQueue::Add(const ESDrawPacket& packet, EERenderPass pass)
+{
+	if (!packet.mesh || !packet.material || !packet.shader)
+		return;
+
+	// Quantise the distance to the view into 16 bits
+	const float distance = glm::length(glm::vec3(packet.model[3]) - m_viewPosition);
+	const float depth = std::clamp(distance / m_farClip, 0.0f, 1.0f);
+
+	const EUi64 key = MakeKey(pass, packet.shader->GetProgramID(), packet.material->GetID(),
+		packet.mesh->GetVAO(), (EUi16)(depth * 65535.0f));
+
+	m_entries.push_back({ key, (EUi32)m_packets.size() });
+	m_packets.push_back(packet);
+}
+
+EUi64 ERenderQueue::MakeKey(EERenderPass pass, EUi32 shaderID, EUi64 materialID, EUi32 vao, EUi16 depth)
+{
+	return ((EUi64)(pass & 0xF) << 60)
+		| ((EUi64)(shaderID & 0xFF) << 52)
+		| ((materialID & 0xFFFFF) << 32)
+		| ((EUi64)(vao & 0xFFFF) << 16)
+		| (EUi64)depth;
+}
+
+void ERenderQueue::Submit(EShaderProgram* activeShader)
+{
+	EPROFILE_ZONE("Submit Render Queue");
+
+	m_stats = ESRenderStats();
+
+	{
+		EPROFILE_ZONE("Sort Render Queue");
+		std::sort(m_entries.begin(), m_entries.end(),
+			[](const ESSortEntry& a, const ESSortEntry& b) {
+				return a.key < b.key;
+		});
+	}
+
+	UploadInstances();
+
+	// State bound by the last draw, only the shader is known at the start of the submit
+	EShaderProgram* currentShader = activeShader;
+	ESMaterial* currentMaterial = nullptr;
+	const ETexture* boundTextures[textureUnitCount] = { nullptr, nullptr, nullptr };
+	EUi32 currentVAO = 0;
+
+	for (EUi32 first = 0; first < m_entries.size();) {
+		const ESDrawPacket& packet = m_packets[m_entries[first].index];
+
+		// Sorted draws of the same mesh, material and shader are next to each other
+		// Draw them all at once, each instance reading its own model matrix
+		EUi32 count = 1;
+		while (first + count < m_entries.size()) {
+			const ESDrawPacket& next = m_packets[m_entries[first + count].index];
+			if (next.mesh != packet.mesh || next.material != packet.material || next.shader != packet.shader)
+				break;
+
+			++count;
+		}
+
+		// --------- PROGRAM
+		if (packet.shader != currentShader) {
+			packet.shader->Activate();
+			currentShader = packet.shader;
+			currentMaterial = nullptr;
+			++m_stats.programChanges;
+		}
+
+		// --------- MATERIAL
+		if (packet.material != currentMaterial) {
+			// Only bind the maps that are not already bound to their unit
+			ETexture* maps[textureUnitCount] = {
+				packet.material->GetBaseColourMap().get(),
+				packet.material->GetSpecularMap().get(),
+				packet.material->GetNormalMap().get()
+			};
+			const EUi32 units[textureUnitCount] = {
+				ESMaterial::baseColourUnit, ESMaterial::specularUnit, ESMaterial::normalUnit
+			};
+
+			for (EUi32 i = 0; i < textureUnitCount; ++i) {
+				if (maps[i] && maps[i] != boundTextures[i]) {
+					maps[i]->BindTexture(units[i]);
+					boundTextures[i] = maps[i];
+					++m_stats.textureBinds;
+				}
+			}
+
+			packet.material->BindParameterBlock();
+			currentMaterial = packet.material;
+			++m_stats.materialChanges;
+		}
+
+		// --------- VAO
+		if (packet.mesh->GetVAO() != currentVAO) {
+			currentVAO = packet.mesh->GetVAO();
+			glBindVertexArray(currentVAO);
+			packet.mesh->AttachInstanceBuffer(m_instanceBuffer);
+			++m_stats.vaoBinds;
+		}
+
+		packet.mesh->Draw(count, first);
+		++m_stats.drawCalls;
+		m_stats.instances += count;
+
+		first += count;
+	}
+
+	// Clear the VAO
+	glBindVertexArray(0);
+
+	m_packets.clear();
+	m_entries.clear();
+}
+
+void ERenderQueue::UploadInstances()
+{
+	EPROFILE_ZONE("Build Instances");
+
+	// Combine the model and mesh matrix and invert it once per instance instead of once per vertex
+	m_instances.resize(m_entries.size());
+	for (EUi32 i = 0; i < m_entries.size(); ++i) {
+		const ESDrawPacket& packet = m_packets[m_entries[i].index];
+		ESInstanceData& instance = m_instances[i];
+
+		instance.world = packet.model * packet.mesh->GetRelativeTransform();
+
+		const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.world)));
+		instance.normalMatrix[0] = glm::vec4(normalMatrix[0], 0.0f);
+		instance.normalMatrix[1] = glm::vec4(normalMatrix[1], 0.0f);
+		instance.normalMatrix[2] = glm::vec4(normalMatrix[2], 0.0f);
+	}
+
+	if (m_instanceBuffer == 0)
+		glGenBuffers(1, &m_instanceBuffer);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+	// Grow the buffer to fit, otherwise orphan it so the GPU can keep reading last frame
+	const size_t size = m_instances.size() * sizeof(ESInstanceData);
+	if (size > m_instanceCapacity || m_instanceCapacity == 0)
+		m_instanceCapacity = std::max<size_t>(std::max(size, m_instanceCapacity * 2), sizeof(ESInstanceData) * 256);
+
+	glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)m_instanceCapacity, nullptr, GL_STREAM_DRAW);
+
+	if (size > 0)
+		glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)size, m_instances.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
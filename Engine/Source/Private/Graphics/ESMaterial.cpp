@@ -0,0 +1,89 @@
+#include "Graphics/ESMaterial.h"
+#include "Graphics/ETexture.h"
+
+// External Libs
+#include <GLEW/glew.h>
+
+// System Libs
+#include <atomic>
+
+// Next material id, materials can be created on any thread
+static std::atomic<EUi64> s_nextMaterialID = 1;
+
+ESMaterial::ESMaterial()
+{
+	m_id = s_nextMaterialID++;
+	m_version = 1;
+	m_uploadedVersion = 0;
+	m_readyMaps = 0;
+	m_parameterBuffer = 0;
+}
+
+ESMaterial::~ESMaterial()
+{
+	if (m_parameterBuffer != 0)
+		glDeleteBuffers(1, &m_parameterBuffer);
+}
+
+void ESMaterial::Bind()
+{
+	// --------- MAPS
+	if (m_baseColourMap)
+		m_baseColourMap->BindTexture(baseColourUnit);
+
+	if (m_specularMap)
+		m_specularMap->BindTexture(specularUnit);
+
+	if (m_normalMap)
+		m_normalMap->BindTexture(normalUnit);
+
+	BindParameterBlock();
+}
+
+void ESMaterial::BindParameterBlock()
+{
+	// Create the buffer the first time the material is bound
+	if (m_parameterBuffer == 0) {
+		glGenBuffers(1, &m_parameterBuffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_parameterBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(ESMaterialParams), nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	UpdateMapReadiness();
+
+	// Only upload when the material has changed
+	if (m_uploadedVersion != m_version) {
+		ESMaterialParams params = {};
+		params.shininess = m_shininess;
+		params.specularStrength = m_specularStrength;
+		params.brightness = m_brightness;
+		params.textureDepth = m_textureDepth;
+		params.hasNormalMap = (m_readyMaps & MM_NORMAL) ? 1 : 0;
+		params.hasSpecularMap = (m_readyMaps & MM_SPECULAR) ? 1 : 0;
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_parameterBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ESMaterialParams), &params);
+		m_uploadedVersion = m_version;
+	}
+
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, parameterBinding, m_parameterBuffer);
+}
+
+void ESMaterial::UpdateMapReadiness()
+{
+	EUi8 readyMaps = 0;
+	if (m_baseColourMap && m_baseColourMap->IsReady())
+		readyMaps |= MM_BASE_COLOUR;
+
+	if (m_specularMap && m_specularMap->IsReady())
+		readyMaps |= MM_SPECULAR;
+
+	if (m_normalMap && m_normalMap->IsReady())
+		readyMaps |= MM_NORMAL;
+
+	if (readyMaps != m_readyMaps) {
+		m_readyMaps = readyMaps;
+		++m_version;
+	}
+}
@@ -3,8 +3,9 @@
 #include "Math/ESTransform.h"
 #include "Graphics/ETexture.h"
 #include "Graphics/ESCamera.h"
-#include "Graphics/ESLight.h"
 #include "Graphics/ESMaterial.h"
+#include "IO/EMappedFile.h"
+#include "IO/ESFileStamp.h"
 
 // External Libs
 #include <GLEW/glew.h>
@@ -13,11 +14,82 @@
 // System Libs
 #include <fstream>
 #include <sstream>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+// Names of the engine uniforms in the shaders, in EEUniform order
+static const char* const engineUniformNames[U_COUNT] = {
+	"mesh",
+	"model",
+	"view",
+	"projection",
+	"viewProjection",
+	"textureDepth",
+	"material.baseColourMap",
+	"material.specularMap",
+	"material.normalMap",
+	"addedDirLights",
+	"addedPointLights",
+	"addedSpotLights",
+	"brightness",
+	"wireColour",
+	"sprite",
+	"color",
+	"useTexture"
+};
+
+// Program cache file, the header then the binary the driver saved for the linked program
+struct ESProgramCacheHeader {
+	EUi32 magic;
+	EUi32 version;
+
+	// Hash of the vertex and fragment sources
+	EUi64 sourceHash;
+
+	// Hash of the driver strings, binaries only load on the driver that saved them
+	EUi64 driverHash;
+
+	// Driver format of the binary and its size in bytes
+	EUi32 binaryFormat;
+	EUi32 binarySize;
+};
+
+static_assert(sizeof(ESProgramCacheHeader) == 32, "Program cache header must have no hidden padding");
+
+// Folder the program binaries are saved to, binaries only work with the driver that saved them so they are never shipped
+static const EString programCacheFolder = "ShaderCache/";
+static const EString programCacheExtension = ".eprog";
+
+// "EPRG" read as a little endian integer
+static const EUi32 programCacheMagic = 0x47525045;
+
+// Increase when the header changes so old files are ignored
+static const EUi32 programCacheVersion = 1;
+
+// Hash the vendor, renderer and version of the driver, a driver update changes the version
+static EUi64 GetDriverHash()
+{
+	EString driver;
+	for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		const GLubyte* value = glGetString(name);
+		driver += value ? reinterpret_cast<const char*>(value) : "";
+		driver += '\n';
+	}
+
+	return ESFileStamp::HashBytes(reinterpret_cast<const EUi8*>(driver.data()), driver.size());
+}
 
-// Constant value for light amounts
-const EUi32 maxDirLights = 2;
-const EUi32 maxPointLights = 20;
-const EUi32 maxSpotLights = 20;
+// Get the cache file of a pair of shaders, named after the vertex shader with a hash of both paths
+static EString GetProgramCachePath(const EString& vShaderPath, const EString& fShaderPath)
+{
+	const EString paths = vShaderPath + "|" + fShaderPath;
+	const EUi64 pathHash = ESFileStamp::HashBytes(reinterpret_cast<const EUi8*>(paths.data()), paths.size());
+
+	std::stringstream name;
+	name << programCacheFolder << std::filesystem::path(vShaderPath).stem().string() << "_" << std::hex << pathHash << programCacheExtension;
+	return name.str();
+}
 
 #define EGET_GLEW_ERROR reinterpret_cast<const char*>(glewGetErrorString(glGetError()))
 
@@ -26,6 +98,12 @@ EShaderProgram::EShaderProgram()
 	m_programID = 0;
 	m_defaultTextureDepth = 1.0f;
 	m_textureDepth = m_defaultTextureDepth;
+	m_boundMaterialID = 0;
+	m_boundMaterialVersion = 0;
+
+	for (int& location : m_engineUniforms) {
+		location = -1;
+	}
 }
 
 EShaderProgram::~EShaderProgram()
@@ -35,6 +113,22 @@ EShaderProgram::~EShaderProgram()
 
 bool EShaderProgram::InitShader(const EString& vShaderPath, const EString& fShaderPath)
 {
+	typedef std::chrono::high_resolution_clock EClock;
+	const auto start = EClock::now();
+
+	m_filePath[ST_VERTEX] = vShaderPath;
+	m_filePath[ST_FRAGMENT] = fShaderPath;
+
+	// Read both sources first, their hash decides if the cached program can be used
+	const EString vShaderStr = ConvertFileToString(vShaderPath);
+	const EString fShaderStr = ConvertFileToString(fShaderPath);
+
+	// If either of the shaders fail to import then fail the whole program
+	if (vShaderStr.empty() || fShaderStr.empty()) {
+		EDebug::Log("Shader program failed to initalise, could not import shaders.");
+		return false;
+	}
+
 	// Create the shader program in OpenGL
 	m_programID = glCreateProgram();
 
@@ -45,91 +139,81 @@ bool EShaderProgram::InitShader(const EString& vShaderPath, const EString& fShad
 		return false;
 	}
 
-	// If either of the shaders fail to import then fail the whole program
-	if (!ImportShaderByType(vShaderPath, ST_VERTEX) || !ImportShaderByType(fShaderPath, ST_FRAGMENT)) {
+	const EString sources = vShaderStr + '\0' + fShaderStr;
+	const EUi64 sourceHash = ESFileStamp::HashBytes(reinterpret_cast<const EUi8*>(sources.data()), sources.size());
+	const EString cachePath = GetProgramCachePath(vShaderPath, fShaderPath);
+
+	// Skip compiling when the program was cached from the same sources on this driver
+	if (LoadProgramBinary(cachePath, sourceHash)) {
+		ReflectUniforms();
+
+		const double ms = std::chrono::duration<double, std::milli>(EClock::now() - start).count();
+		EDebug::Log("Shader loaded from the program cache in " + std::to_string(ms) + " ms: " + vShaderPath + ", " + fShaderPath);
+		return true;
+	}
+
+	if (!CompileShader(vShaderStr, ST_VERTEX) || !CompileShader(fShaderStr, ST_FRAGMENT)) {
 		EDebug::Log("Shader program failed to initalise, could not import shaders.");
 		return false;
 	}
-	
-	return LinkToGPU();
+
+	// Let the driver keep the linked binary so it can be cached
+	glProgramParameteri(m_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+	if (!LinkToGPU())
+		return false;
+
+	SaveProgramBinary(cachePath, sourceHash);
+
+	const double ms = std::chrono::duration<double, std::milli>(EClock::now() - start).count();
+	EDebug::Log("Shader compiled in " + std::to_string(ms) + " ms: " + vShaderPath + ", " + fShaderPath);
+	return true;
 }
 
 void EShaderProgram::Activate()
 {
 	glUseProgram(m_programID);
+
+	// Texture units may have been changed by another shader so set the next material again
+	m_boundMaterialID = 0;
 }
 
 void EShaderProgram::SetMeshTransform(const glm::mat4& matTransform)
 {
-	// Find the variable in the shader
-	// All the uniform variables are given an ID by OpenGL
-	const int varID = glGetUniformLocation(m_programID, "mesh");
-	// Update the value
+	// Update the value using the location found when the shader linked
 	glUniformMatrix4fv(
-		varID, 1, GL_FALSE, glm::value_ptr(matTransform));
+		m_engineUniforms[U_MESH], 1, GL_FALSE, glm::value_ptr(matTransform));
 }
 
 void EShaderProgram::SetModelTransform(const ESTransform& transform)
 {
-	// Translate (move) > rotate > scale
-	// This allows us to rotate around the new location
-	// Initialise a default matrix transform
-	glm::mat4 matrixT = glm::mat4(1.0f);
-
-	// Translate matrix
-	matrixT = glm::translate(matrixT, transform.position);
-
-	// Rotate matrix
-	matrixT = glm::rotate(matrixT, glm::radians(transform.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-	matrixT = glm::rotate(matrixT, glm::radians(transform.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-	matrixT = glm::rotate(matrixT, glm::radians(transform.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-
-	// Scale matrix
-	matrixT = glm::scale(matrixT, transform.scale);
+	SetModelMatrix(transform.GetMatrix());
+}
 
-	// Find the variable in the shader
-	// All the uniform variables are given an ID by OpenGL
-	const int varID = glGetUniformLocation(m_programID, "model");
+void EShaderProgram::SetModelMatrix(const glm::mat4& matModel)
+{
 	// Update the value
 	glUniformMatrix4fv(
-		varID, 1, GL_FALSE, glm::value_ptr(matrixT));
+		m_engineUniforms[U_MODEL], 1, GL_FALSE, glm::value_ptr(matModel));
 }
 
-void EShaderProgram::SetWorldTransform(const TShared<ESCamera>& camera)
+void EShaderProgram::SetWorldTransform(const TShared<ESCamera>& camera, float renderAlpha)
 {
-	// Initialise a matrix
-	glm::mat4 matrixT = glm::mat4(1.0f);
-
-	// Handle the view matrix
-	// Translate and rotate the matrix based on the cameras forward and up vector
-	matrixT = glm::lookAt(
-		camera->transform.position,
-		camera->transform.position + camera->transform.Forward(),
-		camera->transform.Up()
-	);
-
-	// Find the variable in the shader for the view matrix
-	int varID = glGetUniformLocation(m_programID, "view");
+	// Uses the camera transform blended between the last two ticks
+	const glm::mat4 view = camera->GetViewMatrix(renderAlpha);
+	const glm::mat4 projection = camera->GetProjectionMatrix();
 
 	// Update the view matrix value in the shader
 	glUniformMatrix4fv(
-		varID, 1, GL_FALSE, glm::value_ptr(matrixT));
-
-	// Handle the projection matrix
-	// Set the projection matrix to a perspective view
-	matrixT = glm::perspective(
-		glm::radians(camera->fov),	// Zoom of camera
-		camera->aspectRatio,		// How wide the view is
-		camera->nearClip,			// How close 3D models can be seen
-		camera->farClip				// How far 3D models can be seen
-	);								// - all other models will not render
-
-	// Find the variable in the shader for the projection matrix
-	varID = glGetUniformLocation(m_programID, "projection");
+		m_engineUniforms[U_VIEW], 1, GL_FALSE, glm::value_ptr(view));
 
 	// Update the projection matrix value in the shader
 	glUniformMatrix4fv(
-		varID, 1, GL_FALSE, glm::value_ptr(matrixT));
+		m_engineUniforms[U_PROJECTION], 1, GL_FALSE, glm::value_ptr(projection));
+
+	// Combine the view and projection once so vertices only need one multiply to reach the screen
+	glUniformMatrix4fv(
+		m_engineUniforms[U_VIEW_PROJECTION], 1, GL_FALSE, glm::value_ptr(projection * view));
 }
 
 void EShaderProgram::SetSpriteTransform(const ESTransform2D& transform)
@@ -137,229 +221,12 @@ void EShaderProgram::SetSpriteTransform(const ESTransform2D& transform)
 
 }
 
-void EShaderProgram::SetLights(const TArray<TShared<ESLight>>& lights)
-{	
-	// Set number of lights in the shader
-	// Max out to ensure lights can be added
-	SetNumberOfLights((int)maxDirLights, (int)maxPointLights, (int)maxSpotLights);
-	
-	// Number of created lights
-	EUi32 dirLights = 0;
-	EUi32 pointLights = 0;
-	EUi32 spotLights = 0;
-
-	// Name of the variable array. Will set in the loop depending on light type
-	EString lightIndexStr = "";
-	int varID = 0;
-
-	// Loop through all of the lights and add them to the shader
-	for (EUi32 i = 0; i < lights.size(); ++i) {
-		// ----------- DIRECTIONAL LIGHTS
-		if (const auto& lightRef = std::dynamic_pointer_cast<ESDirLight>(lights[i])) {
-			// Ignore dirLight if has reached max number
-			if (dirLights >= maxDirLights || !lightRef->isLightOn)
-				continue;
-			
-			// Add a dirLight and use as index
-			lightIndexStr = "dirLights[" + std::to_string(dirLights) + "]";
-			
-			// --------- COLOR
-			// Get the colour variable from the dirLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".colour").c_str());
-
-			// Change the colour
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->colour));
-
-			// --------- AMBIENT
-			// Get the ambient variable from the dirLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".ambient").c_str());
-
-			// Change the ambient colour
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->ambient));
-
-			// --------- DIRECTION
-			// Get the direction variable from the dirLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".direction").c_str());
-
-			// Change the direction
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->direction));
-
-			// --------- INTENSITY
-			// Get the intensity variable from the dirLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".intensity").c_str());
-
-			// Change the intensity
-			glUniform1f(varID, lightRef->intensity);
-
-			// Increment the number of dirLights
-			++dirLights;
-			continue;
-		}
-
-		// ----------- POINT LIGHTS
-		if (const auto& lightRef = std::dynamic_pointer_cast<ESPointLight>(lights[i])) {
-			// Ensure only max lights
-			if (pointLights >= maxPointLights || !lightRef->isLightOn) {
-				continue;
-			}
-			
-			// Add a point light and use as index
-			lightIndexStr = "pointLights[" + std::to_string(pointLights) + "]";
-
-			// --------- COLOR
-			// Get the colour variable from the pointLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".colour").c_str());
-
-			// Change the colour
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->colour));
-
-			// --------- POSITION
-			// Get the position variable from the pointLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".position").c_str());
-
-			// Change the position
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->position));
-
-			// --------- INTENSITY
-			// Get the intensity variable from the pointLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".intensity").c_str());
-
-			// Change the intensity
-			glUniform1f(varID, lightRef->intensity);
-
-			// --------- LINEAR ATTENUATION
-			// Get the linear variable from the pointLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".linear").c_str());
-
-			// Change the linear attenuation
-			glUniform1f(varID, lightRef->linear);
-
-			// --------- QUADRATIC ATTENUATION
-			// Get the quadratic variable from the pointLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".quadratic").c_str());
-
-			// Change the quadratic attenuation
-			glUniform1f(varID, lightRef->quadratic);
-
-			// Increment the number of pointLights
-			++pointLights;
-			continue;
-		}
-
-		// ----------- SPOT LIGHTS
-		if (const auto& lightRef = std::dynamic_pointer_cast<ESSpotLight>(lights[i])) {
-			// Ensure only max lights
-			if (spotLights >= maxSpotLights || !lightRef->isLightOn) {
-				continue;
-			}
-
-			// Add a spot light and use as index
-			lightIndexStr = "spotLights[" + std::to_string(spotLights) + "]";
-
-			// --------- COLOR
-			// Get the colour variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".colour").c_str());
-
-			// Change the colour
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->colour));
-
-			// --------- POSITION
-			// Get the position variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".position").c_str());
-
-			// Change the position
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->position));
-
-			// --------- DIRECTION
-			// Get the direction variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".direction").c_str());
-
-			// Change the direction
-			glUniform3fv(varID, 1, glm::value_ptr(lightRef->direction));
-
-			// --------- INNER CUT OFF
-			// Get the inner cut off variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".innerCutOff").c_str());
-
-			// Change the inner cut off
-			glUniform1f(varID, glm::cos(glm::radians(lightRef->innerCutOff)));
-
-			// --------- OUTER CUT OFF
-			// Get the outer cut off variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".outerCutOff").c_str());
-
-			// Change the outer cut off
-			glUniform1f(varID, glm::cos(glm::radians(lightRef->outerCutOff)));
-
-			// --------- INTENSITY
-			// Get the intensity variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".intensity").c_str());
-
-			// Change the intensity
-			glUniform1f(varID, lightRef->intensity);
-
-			// --------- LINEAR ATTENUATION
-			// Get the linear variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".linear").c_str());
-
-			// Change the linear attenuation
-			glUniform1f(varID, lightRef->linear);
-
-			// --------- QUADRATIC ATTENUATION
-			// Get the quadratic variable from the spotLight struct in the shader
-			varID = glGetUniformLocation(m_programID,
-				(lightIndexStr + ".quadratic").c_str());
-
-			// Change the quadratic attenuation
-			glUniform1f(varID, lightRef->quadratic);
-
-			// Increment the number of spotLights
-			++spotLights;
-			continue;
-		}
-	}
-
-	// Cap the values so unused lights are not drawn to the shader
-	SetNumberOfLights((int)dirLights, (int)pointLights, (int)spotLights);
-}
-
 void EShaderProgram::SetNumberOfLights(const int& dirLights, const int& pointLights, const int& spotLights)
 {
-	int varID = 0;
-	
-	//  ---------- Set number of dir lights in shader
-	// Get the addedDirLight variable in the shader
-	varID = glGetUniformLocation(m_programID, "addedDirLights");
-	// Set the number of added Dir Lights
-	glUniform1i(varID, dirLights);
-
-	//  ---------- Set number of point lights in shader
-	// Get the addedPointLight variable in the shader
-	varID = glGetUniformLocation(m_programID, "addedPointLights");
-	// Set the number of added Point Lights
-	glUniform1i(varID, pointLights);
-
-	//  ---------- Set number of spot lights in shader
-	// Get the addedSpotLight variable in the shader
-	varID = glGetUniformLocation(m_programID, "addedSpotLights");
-	// Set the number of added Spot Lights
-	glUniform1i(varID, spotLights);
+	// Set the number of added lights of each type
+	glUniform1i(m_engineUniforms[U_ADDED_DIR_LIGHTS], dirLights);
+	glUniform1i(m_engineUniforms[U_ADDED_POINT_LIGHTS], pointLights);
+	glUniform1i(m_engineUniforms[U_ADDED_SPOT_LIGHTS], spotLights);
 }
 
 void EShaderProgram::SetMaterial(const TShared<ESMaterial>& material)
@@ -367,134 +234,60 @@ void EShaderProgram::SetMaterial(const TShared<ESMaterial>& material)
 	if (material == nullptr)
 		return;
 
-	// ID for the variable in the shader
-	int varID = 0;
-
-	// --------- BASE COLOUR
-	if (material->m_baseColourMap) {
-		// Bind the texture to the 0 index
-		material->m_baseColourMap->BindTexture(0);
-		// Get the base colour map ID
-		varID = glGetUniformLocation(m_programID, "material.baseColourMap");
-		// Update the shader
-		glUniform1i(varID, 0);
-	}
-
-	// --------- SPECULAR
-	if (material->m_specularMap) {
-		// Bind the texture to the 1 index
-		material->m_specularMap->BindTexture(1);
-		// Get the specular map ID
-		varID = glGetUniformLocation(m_programID, "material.specularMap");
-		// Update the shader
-		glUniform1i(varID, 1);
-	}
-
-	// --------- NORMAL
-	if (material->m_normalMap) {
-		// Bind the texture to the 2 index
-		material->m_normalMap->BindTexture(2);
-		// Get the normal map ID
-		varID = glGetUniformLocation(m_programID, "material.normalMap");
-		// Update the shader
-		glUniform1i(varID, 2);
-	}
-
-	// --------- SHININESS
-	// Get the shininess ID
-	varID = glGetUniformLocation(m_programID, "material.shininess");
-	// Update the shader
-	glUniform1f(varID, material->m_shininess);
-
-	// --------- SPECULAR STRENGTH
-	// Get the specular strength ID
-	varID = glGetUniformLocation(m_programID, "material.specularStrength");
-	// Update the shader
-	glUniform1f(varID, material->m_specularStrength);
+	// A map finishing its upload changes the material block
+	material->UpdateMapReadiness();
 
-	// --------- BRIGHTNESS
-	// Get the brightness ID
-	varID = glGetUniformLocation(m_programID, "material.brightness");
-	// Update the shader
-	glUniform1f(varID, material->m_brightness);
+	// Skip if the material is already bound and has not changed
+	if (material->GetID() == m_boundMaterialID && material->GetVersion() == m_boundMaterialVersion)
+		return;
 
-	// --------- MATERIAL TEXTURE DEPTH
-	// Get the material texture depth ID
-	varID = glGetUniformLocation(m_programID, "materialTextureDepth");
-	// Update the shader
-	glUniform1f(varID, material->m_textureDepth);
-
-	// --------- HAS NORMAL MAP
-	varID = glGetUniformLocation(m_programID, "hasNormalMap");
-	if (material->m_normalMap) {
-		material->m_normalMap->BindTexture(2);
-		glUniform1i(glGetUniformLocation(m_programID, "material.normalMap"), 2);
-		glUniform1i(varID, true);
-	}
-	else {
-		glUniform1i(varID, false);
-	}
+	// Bind the maps and the material block, the block is only uploaded if the material changed
+	material->Bind();
 
-	// --------- HAS SPECULAR MAP
-	varID = glGetUniformLocation(m_programID, "hasSpecularMap");
-	if (material->m_specularMap) {
-		material->m_specularMap->BindTexture(2);
-		glUniform1i(glGetUniformLocation(m_programID, "material.specularMap"), 2);
-		glUniform1i(varID, true);
-	}
-	else {
-		glUniform1i(varID, false);
-	}
+	m_boundMaterialID = material->GetID();
+	m_boundMaterialVersion = material->GetVersion();
 }
 
 void EShaderProgram::SetWireColour(const glm::vec3& colour)
 {
-	// Get the wire colour variable from the shader
-	int varID = glGetUniformLocation(m_programID, "wireColour");
-
 	// Change the colour
-	glUniform3fv(varID, 1, glm::value_ptr(colour));
+	glUniform3fv(m_engineUniforms[U_WIRE_COLOUR], 1, glm::value_ptr(colour));
 }
 
 void EShaderProgram::SetBrightness(const float& brightness)
 {
-	// Get the brightness ID
-	int varID = glGetUniformLocation(m_programID, "brightness");
 	// Update the shader
-	glUniform1f(varID, brightness);
+	glUniform1f(m_engineUniforms[U_BRIGHTNESS], brightness);
 }
 
 void EShaderProgram::AdjustTextureDepth(float delta)
 {
-	// Find the variable in the shader
-	// All the uniform variables are given an ID by OpenGL
-	const int varID = glGetUniformLocation(m_programID, "textureDepth");
 	// Update the value
 	m_textureDepth += delta;
-	glUniform1f(varID, m_textureDepth);
+	glUniform1f(m_engineUniforms[U_TEXTURE_DEPTH], m_textureDepth);
 }
 
 void EShaderProgram::ResetTextureDepth()
 {
-	// Find the variable in the shader
-	// All the uniform variables are given an ID by OpenGL
-	const int varID = glGetUniformLocation(m_programID, "textureDepth");
 	// Update the value
 	m_textureDepth = m_defaultTextureDepth;
-	glUniform1f(varID, m_defaultTextureDepth);
+	glUniform1f(m_engineUniforms[U_TEXTURE_DEPTH], m_defaultTextureDepth);
 }
 
-bool EShaderProgram::ImportShaderByType(const EString& filePath, EEShaderType shaderType)
+int EShaderProgram::GetUniformLocation(EUi32 nameHash) const
 {
-	// Convert the shader to a string
-	const EString shaderStr = ConvertFileToString(filePath);
-	
-	// Make sure there is a string path
-	if (shaderStr.empty()) {
-		EDebug::Log("Shader failed to import.", LT_ERROR);
-		return false;
-	}
+	const auto it = m_uniformLocations.find(nameHash);
+	return it != m_uniformLocations.end() ? it->second : -1;
+}
+
+int EShaderProgram::GetBlockIndex(EUi32 nameHash) const
+{
+	const auto it = m_blockIndices.find(nameHash);
+	return it != m_blockIndices.end() ? it->second : -1;
+}
 
+bool EShaderProgram::CompileShader(const EString& shaderStr, EEShaderType shaderType)
+{
 	// Set and create and ID for the shader based on the shader type
 	switch (shaderType)
 	{
@@ -585,5 +378,172 @@ bool EShaderProgram::LinkToGPU()
 
 	EDebug::Log("Shader successfully initialised and linked at index " + std::to_string(m_programID));
 
+	// Find the uniform locations once so draws never look them up
+	ReflectUniforms();
+
 	return true;
 }
+
+bool EShaderProgram::LoadProgramBinary(const EString& cachePath, EUi64 sourceHash)
+{
+	// Drivers with no binary formats can't load cached programs
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	if (formatCount <= 0)
+		return false;
+
+	EMappedFile file;
+	if (!file.Open(cachePath))
+		return false;
+
+	// Check the binary was saved from these sources by this driver
+	ESProgramCacheHeader header;
+	if (file.GetSize() < sizeof(header))
+		return false;
+
+	std::memcpy(&header, file.GetData(), sizeof(header));
+	if (header.magic != programCacheMagic || header.version != programCacheVersion
+		|| header.sourceHash != sourceHash || header.driverHash != GetDriverHash())
+		return false;
+
+	if (sizeof(header) + (size_t)header.binarySize > file.GetSize())
+		return false;
+
+	glProgramBinary(m_programID, header.binaryFormat, file.GetData() + sizeof(header), (GLsizei)header.binarySize);
+
+	GLint success;
+	glGetProgramiv(m_programID, GL_LINK_STATUS, &success);
+
+	if (!success) {
+		// The driver can reject its own binaries, start again with a new program and compile
+		EDebug::Log("Cached shader program was rejected by the driver, compiling instead: " + cachePath, LT_WARNING);
+		glDeleteProgram(m_programID);
+		m_programID = glCreateProgram();
+		return false;
+	}
+
+	return true;
+}
+
+void EShaderProgram::SaveProgramBinary(const EString& cachePath, EUi64 sourceHash) const
+{
+	GLint binarySize = 0;
+	glGetProgramiv(m_programID, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+	if (binarySize <= 0)
+		return;
+
+	// Read the binary straight into the file after the header
+	TArray<EUi8> fileData(sizeof(ESProgramCacheHeader) + (size_t)binarySize);
+	GLsizei writtenSize = 0;
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(m_programID, binarySize, &writtenSize, &binaryFormat, fileData.data() + sizeof(ESProgramCacheHeader));
+	if (writtenSize <= 0)
+		return;
+
+	ESProgramCacheHeader header = {};
+	header.magic = programCacheMagic;
+	header.version = programCacheVersion;
+	header.sourceHash = sourceHash;
+	header.driverHash = GetDriverHash();
+	header.binaryFormat = binaryFormat;
+	header.binarySize = (EUi32)writtenSize;
+	std::memcpy(fileData.data(), &header, sizeof(header));
+	fileData.resize(sizeof(header) + (size_t)writtenSize);
+
+	std::error_code error;
+	std::filesystem::create_directories(programCacheFolder, error);
+
+	// Write to a temporary file first so a failed write never leaves a broken cached program
+	const EString tempPath = cachePath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(fileData.data()), (std::streamsize)fileData.size());
+
+		if (!file) {
+			EDebug::Log("Failed to write cached shader program: " + cachePath, LT_WARNING);
+			return;
+		}
+	}
+
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error) {
+		EDebug::Log("Failed to write cached shader program: " + cachePath + ": " + error.message(), LT_WARNING);
+		std::filesystem::remove(tempPath, error);
+	}
+}
+
+void EShaderProgram::ReflectUniforms()
+{
+	m_uniformLocations.clear();
+	m_blockIndices.clear();
+
+	// Name buffer long enough for the longest uniform name
+	GLint maxNameLength = 0;
+	glGetProgramInterfaceiv(m_programID, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+	EString name(std::max(maxNameLength, 1), '\0');
+
+	// --------- UNIFORMS
+	GLint uniformCount = 0;
+	glGetProgramInterfaceiv(m_programID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+
+	const GLenum uniformProps[] = { GL_LOCATION, GL_ARRAY_SIZE };
+	for (GLint i = 0; i < uniformCount; ++i) {
+		GLint values[2] = { -1, 0 };
+		glGetProgramResourceiv(m_programID, GL_UNIFORM, i, 2, uniformProps, 2, nullptr, values);
+
+		// Uniforms in blocks have no location
+		if (values[0] < 0)
+			continue;
+
+		GLsizei nameLength = 0;
+		glGetProgramResourceName(m_programID, GL_UNIFORM, i, (GLsizei)name.size(), &nameLength, name.data());
+		const std::string_view uniformName(name.data(), nameLength);
+
+		const EUi32 nameHash = HashName(uniformName);
+		if (m_uniformLocations.count(nameHash) > 0)
+			EDebug::Log("Shader uniform name hash collision: " + EString(uniformName), LT_WARNING);
+
+		m_uniformLocations[nameHash] = values[0];
+
+		// Arrays of basic types are one resource named "name[0]"
+		// Add the array name and every element so each can be found by name
+		if (values[1] > 1 && uniformName.ends_with("[0]")) {
+			const EString arrayName(uniformName.substr(0, uniformName.size() - 3));
+			m_uniformLocations[HashName(arrayName)] = values[0];
+
+			for (GLint element = 1; element < values[1]; ++element) {
+				m_uniformLocations[HashName(arrayName + "[" + std::to_string(element) + "]")] = values[0] + element;
+			}
+		}
+	}
+
+	// --------- BLOCKS
+	for (const GLenum blockInterface : { GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK }) {
+		GLint blockCount = 0;
+		glGetProgramInterfaceiv(m_programID, blockInterface, GL_ACTIVE_RESOURCES, &blockCount);
+		glGetProgramInterfaceiv(m_programID, blockInterface, GL_MAX_NAME_LENGTH, &maxNameLength);
+		EString blockName(std::max(maxNameLength, 1), '\0');
+
+		for (GLint i = 0; i < blockCount; ++i) {
+			GLsizei nameLength = 0;
+			glGetProgramResourceName(m_programID, blockInterface, i, (GLsizei)blockName.size(), &nameLength, blockName.data());
+			m_blockIndices[HashName(std::string_view(blockName.data(), nameLength))] = i;
+		}
+	}
+
+	// --------- ENGINE UNIFORMS
+	for (EUi32 i = 0; i < U_COUNT; ++i) {
+		m_engineUniforms[i] = GetUniformLocation(HashName(engineUniformNames[i]));
+	}
+
+	// --------- SAMPLERS
+	// Texture units never change so set the samplers once
+	if (m_engineUniforms[U_BASE_COLOUR_MAP] >= 0)
+		glProgramUniform1i(m_programID, m_engineUniforms[U_BASE_COLOUR_MAP], ESMaterial::baseColourUnit);
+	if (m_engineUniforms[U_SPECULAR_MAP] >= 0)
+		glProgramUniform1i(m_programID, m_engineUniforms[U_SPECULAR_MAP], ESMaterial::specularUnit);
+	if (m_engineUniforms[U_NORMAL_MAP] >= 0)
+		glProgramUniform1i(m_programID, m_engineUniforms[U_NORMAL_MAP], ESMaterial::normalUnit);
+	if (m_engineUniforms[U_SPRITE] >= 0)
+		glProgramUniform1i(m_programID, m_engineUniforms[U_SPRITE], 0);
+}
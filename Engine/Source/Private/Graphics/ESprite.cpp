@@ -1,5 +1,7 @@
 #include "Graphics/ESprite.h"
 #include "Graphics/EShaderProgram.h"
+#include "Graphics/EGraphicsEngine.h"
+#include "Game/EGameEngine.h"
 #include "Math/ESTransform.h"
 
 // External Libs
@@ -12,9 +14,14 @@ bool ESprite::CreateSprite(const EString& texturePath)
     // Create sprite
     if (!CreateSprite()) return false;
 
-    // Load texture
-    if (!LoadTexture(texturePath, texturePath, false, false)) {
+    // Get the texture from the cache, sprites need its size so wait for it to load
+    const auto& graphicsEngine = EGameEngine::GetGameEngine()->GetGraphicsEngine();
+    m_texture = graphicsEngine->LoadTexture(texturePath, false, false);
+    graphicsEngine->GetAssetManager().Finish(m_texture);
+
+    if (m_texture->GetLoadState() == AS_FAILED) {
         EDebug::Log("ESprite failed to load texture.", LT_ERROR);
+        m_texture = nullptr;
         return false;
     }
 
@@ -37,8 +44,8 @@ bool ESprite::CreateSprite()
         0, 2, 3
     };
 
-    // Create mesh
-    if (!CreateMesh(vertices, indices)) {
+    // Create mesh, sprites only read the positions and tex coords
+    if (!CreateMesh(vertices, indices, ESVertexLayout::Create(VA_TEX_COORDS, vertices))) {
         EDebug::Log("ESprite failed to create mesh.", LT_ERROR);
         return false;
     }
@@ -69,27 +76,22 @@ void ESprite::Render(const TShared<EShaderProgram>& shader, ESTransform2D& trans
     model = glm::translate(model, glm::vec3(-renderScale * 0.5f, 0.0f));
     model = glm::scale(model, glm::vec3(renderScale, 1.0f));
 
-    // Set uniforms
-    GLuint programID = shader->GetProgramID();
-
-    int varID = glGetUniformLocation(programID, "projection");
-    glUniformMatrix4fv(varID, 1, GL_FALSE, glm::value_ptr(projection));
-
-    varID = glGetUniformLocation(programID, "model");
-    glUniformMatrix4fv(varID, 1, GL_FALSE, glm::value_ptr(model));
+    // Set uniforms using the locations found when the shader linked
+    glUniformMatrix4fv(shader->GetUniformLocation(U_PROJECTION), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniformMatrix4fv(shader->GetUniformLocation(U_MODEL), 1, GL_FALSE, glm::value_ptr(model));
 
-    glUniform1i(glGetUniformLocation(programID, "useTexture"), !m_fileName.empty() ? 1 : 0);
+    glUniform1i(shader->GetUniformLocation(U_USE_TEXTURE), m_texture ? 1 : 0);
 
-    glUniform4f(glGetUniformLocation(programID, "color"), 
+    glUniform4f(shader->GetUniformLocation(U_SPRITE_COLOUR), 
         m_renderColor.r, m_renderColor.g, m_renderColor.b, m_renderColor.a);
     
     // Bind texture
-    BindTexture(0);
-    varID = glGetUniformLocation(programID, "sprite");
-    glUniform1i(varID, 0);
+    if (m_texture)
+        m_texture->BindTexture(0);
+    glUniform1i(shader->GetUniformLocation(U_SPRITE), 0);
 
     // Draw
     glBindVertexArray(m_vao);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indices.size()), m_indexType, nullptr);
     glBindVertexArray(0);
 }
\ No newline at end of file
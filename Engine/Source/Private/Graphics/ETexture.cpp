@@ -1,14 +1,30 @@
 #include "Graphics/ETexture.h"
+#include "Graphics/ESCookedTexture.h"
+#include "Game/EGameEngine.h"
+#include "Threading/EJobSystem.h"
 
 // External Libs
 #include <GLEW/glew.h>
 #include <STB_IMAGE/stb_image.h>
 
+// System Libs
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+
+EUi32 ETexture::s_placeholderID = 0;
+
 ETexture::ETexture()
 {
     m_path = m_fileName = "";
     m_ID = 0U;
     m_width = m_height = m_channels = 0;
+    m_repeat = m_linear = true;
+    m_pixels = nullptr;
+    m_type = TT_COLOUR;
+    m_format = TF_UNCOMPRESSED;
+    m_mipCount = 1;
 }
 
 ETexture::~ETexture()
@@ -17,21 +33,80 @@ ETexture::~ETexture()
     if (m_ID > 0)
         glDeleteTextures(1, &m_ID);
 
+    // Free the image if it never uploaded
+    if (m_pixels != nullptr)
+        stbi_image_free(m_pixels);
+
     // EDebug::Log("Texture destroyed: " + m_fileName);
 }
 
 bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool repeat, bool linear)
+{
+    SetSource(fileName, path, repeat, linear);
+
+    // Load and upload straight away
+    RunLoad();
+    RunUpload();
+
+    return IsReady();
+}
+
+void ETexture::SetSource(const EString& fileName, const EString& path, bool repeat, bool linear, EETextureType type)
 {
     // Assign the file name and path
     m_fileName = fileName;
     m_path = path;
+    m_repeat = repeat;
+    m_linear = linear;
+    m_type = type;
+}
+
+bool ETexture::LoadData()
+{
+    // Headless runs have no OpenGL so only read the image size
+    if (EGameEngine::GetGameEngine()->IsHeadless()) {
+        if (!stbi_info(m_path.c_str(), &m_width, &m_height, &m_channels)) {
+            EDebug::Log("Failed to load texture - " + m_fileName + ": " + stbi_failure_reason(), LT_ERROR);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Only mip mapped textures are compressed, nearest filtered sprites keep their exact pixels
+    const bool compress = m_linear;
+    const EString cookedPath = GetCookedPath(m_path, m_type);
 
+    // Use the cooked texture if it was cooked from this version of the source
+    if (compress) {
+        m_compressedData = TMakeUnique<ESCompressedImportData>();
+        if (LoadCookedTexture(cookedPath))
+            return true;
+
+        m_compressedData = nullptr;
+    }
+
+    if (!DecodeImage())
+        return false;
+
+    // Textures the cook step missed are cooked on the asset workers so the next launch can use them
+    // Loads on the main thread upload the decoded image instead of waiting on the encoder
+    // Textures that fail to compress also upload the decoded image
+    if (compress && EJobSystem::GetWorkerIndex() != 0 && CompressTexture())
+        SaveCookedTexture(cookedPath);
+
+    return true;
+}
+
+bool ETexture::DecodeImage()
+{
     // STB Image imports images upside down
     // But OpenGL reads them in an inverted state
-    stbi_set_flip_vertically_on_load(true);
+    // Set for this thread only as textures load on many threads at once
+    stbi_set_flip_vertically_on_load_thread(true);
 
     // Load the image into a computer readable format
-    unsigned char* data = stbi_load(
+    m_pixels = stbi_load(
         m_path.c_str(),         // Path to the image
         &m_width, &m_height,    // Width and height of the image
         &m_channels,            // RGBA
@@ -42,7 +117,7 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
     //EDebug::Log("Texture: " + fileName + " | Channels: " + std::to_string(m_channels));
 
     // Test if the data imported correctly
-    if (data == nullptr) {
+    if (m_pixels == nullptr) {
         EString errorMsg = "Failed to load texture - " + m_fileName + ": " + stbi_failure_reason();
         EDebug::Log(errorMsg, LT_ERROR);
         return false;
@@ -52,9 +127,84 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
     if (m_channels > 4 || m_channels < 3) {
         EDebug::Log("Failed to import texture - " + m_fileName 
             + ": Incorrect number of channels, must have 3 or 4 channels");
+        stbi_image_free(m_pixels);
+        m_pixels = nullptr;
         return false;
     }
 
+    return true;
+}
+
+bool ETexture::CookTexture(const EString& path, EETextureType type)
+{
+    // Never uploaded so it needs no OpenGL
+    ETexture texture;
+    texture.SetSource(path, path, true, true, type);
+
+    const EString cookedPath = GetCookedPath(path, type);
+
+    // Skip textures already cooked from the current source
+    texture.m_compressedData = TMakeUnique<ESCompressedImportData>();
+    if (texture.LoadCookedTexture(cookedPath))
+        return true;
+
+    texture.m_compressedData = nullptr;
+
+    if (!texture.DecodeImage() || !texture.CompressTexture())
+        return false;
+
+    if (!texture.SaveCookedTexture(cookedPath))
+        return false;
+
+    EDebug::Log("Cooked texture: " + cookedPath);
+    return true;
+}
+
+bool ETexture::CookFolder(const EString& folder)
+{
+    std::error_code error;
+    if (!std::filesystem::is_directory(folder, error)) {
+        EDebug::Log("Failed to cook folder, it does not exist: " + folder, LT_ERROR);
+        return false;
+    }
+
+    EUi32 cooked = 0, failed = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(folder)) {
+        const EString extension = entry.path().extension().string();
+        if (extension != ".png" && extension != ".jpg" && extension != ".jpeg")
+            continue;
+
+        const EString path = entry.path().generic_string();
+        if (CookTexture(path, GetTypeFromName(path)))
+            ++cooked;
+        else
+            ++failed;
+    }
+
+    EDebug::Log("Cooked " + toEString(cooked) + " textures in " + folder + ", " + toEString(failed) + " failed",
+        failed > 0 ? LT_WARNING : LT_SUCCESS);
+
+    return failed == 0;
+}
+
+EETextureType ETexture::GetTypeFromName(const EString& path)
+{
+    // Normal maps are named with _n or Normal in the sample content
+    const EString stem = std::filesystem::path(path).stem().string();
+    return stem.ends_with("_n") || stem.find("Normal") != EString::npos ? TT_NORMAL : TT_COLOUR;
+}
+
+EString ETexture::GetCookedPath(const EString& path, EETextureType type)
+{
+    return path + (type == TT_NORMAL ? cookedNormalMapExtension : cookedTextureExtension);
+}
+
+bool ETexture::UploadData()
+{
+    // Headless textures only have their size
+    if (EGameEngine::GetGameEngine()->IsHeadless())
+        return true;
+
     // Generate the texture ID in OpenGL
     glGenTextures(1, &m_ID);
 
@@ -63,6 +213,9 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
         EString error = reinterpret_cast<const char*>(glewGetErrorString(glGetError()));
         EString errorMsg = "Failed to generate texture ID - " + m_fileName + ": " + error;
         EDebug::Log(errorMsg, LT_ERROR);
+        stbi_image_free(m_pixels);
+        m_pixels = nullptr;
+        m_compressedData = nullptr;
         return false;
     }
     
@@ -73,18 +226,26 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
     // Set default parameters for the texture
     // Set the texture wrapping parameters
     // If the texture does not fit the model, repeat texture
-    GLint wrapMode = repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    GLint wrapMode = m_repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
 
     // Set the filtering parameters
     // How much to blur pixels 
     // The resolution of the texture is lower than the size of the model
-    GLint filter = linear ? GL_LINEAR : GL_NEAREST;
-    GLint minFilter = linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST;
+    GLint filter = m_linear ? GL_LINEAR : GL_NEAREST;
+    GLint minFilter = m_linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
 
+    // Compressed textures already have their mip maps
+    if (m_compressedData) {
+        UploadCompressedMips();
+        Unbind();
+        m_compressedData = nullptr;
+        return true;
+    }
+
     // Set the default format at 3 channels
     GLint intFormat = GL_RGB;
 
@@ -108,7 +269,7 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
         0,                  // Image border (legacy)
         intFormat,          // External texture format
         GL_UNSIGNED_BYTE,   // Data type passed in
-        data                // Image Data from STBI
+        m_pixels            // Image Data from STBI
     );
 
     // Reset alignment to 4-byte default
@@ -123,7 +284,8 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
     Unbind();
 
     // Clear STBI Image data
-    stbi_image_free(data);
+    stbi_image_free(m_pixels);
+    m_pixels = nullptr;
 
     // Log the success of the import
     // EDebug::Log("Successfully imported texture - " + m_fileName, LT_SUCCESS);
@@ -131,11 +293,177 @@ bool ETexture::LoadTexture(const EString& fileName, const EString& path, bool re
     return true;
 }
 
+size_t ETexture::GetUploadSize() const
+{
+    return GetMemorySize();
+}
+
+size_t ETexture::GetMemorySize() const
+{
+    if (m_format != TF_UNCOMPRESSED)
+        return ETextureCompressor::GetImageSize(m_format, m_width, m_height, m_mipCount);
+
+    // Mip maps add about a third
+    return (size_t)m_width * m_height * m_channels * 4 / 3;
+}
+
+bool ETexture::LoadCookedTexture(const EString& cookedPath)
+{
+    EMappedFile& file = m_compressedData->cookedFile;
+    if (!file.Open(cookedPath))
+        return false;
+
+    const EUi8* data = file.GetData();
+    const size_t size = file.GetSize();
+
+    // Check the file was cooked by this version of the engine from the current source
+    ESCookedTextureHeader header;
+    if (size < sizeof(header))
+        return false;
+
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != ddsMagic || header.engineMagic != cookedTextureMagic || header.engineVersion != cookedTextureVersion)
+        return false;
+
+    EETextureFormat format = TF_UNCOMPRESSED;
+    switch (header.fourCC) {
+    case ddsFourCCBC1: format = TF_BC1; break;
+    case ddsFourCCBC3: format = TF_BC3; break;
+    case ddsFourCCBC5: format = TF_BC5; break;
+    default: return false;
+    }
+
+    // Normal maps must be cooked as normal maps
+    if ((format == TF_BC5) != (m_type == TT_NORMAL))
+        return false;
+
+    if (header.width == 0 || header.height == 0 || header.mipCount != ETextureCompressor::GetMipCount(header.width, header.height))
+        return false;
+
+    if (!header.source.Matches(m_path))
+        return false;
+
+    if (sizeof(header) + ETextureCompressor::GetImageSize(format, header.width, header.height, header.mipCount) > size) {
+        EDebug::Log("Cooked texture is truncated, importing the source instead: " + cookedPath, LT_WARNING);
+        return false;
+    }
+
+    m_width = (int)header.width;
+    m_height = (int)header.height;
+    m_channels = format == TF_BC3 ? 4 : 3;
+    m_format = format;
+    m_mipCount = header.mipCount;
+
+    // The mapped mips go straight to the GPU
+    m_compressedData->mipData = data + sizeof(header);
+    return true;
+}
+
+bool ETexture::CompressTexture()
+{
+    auto compressedData = TMakeUnique<ESCompressedImportData>();
+    ESCompressedImage& image = compressedData->image;
+
+    const EETextureFormat format = ETextureCompressor::ChooseFormat(m_pixels, m_width, m_height, m_channels, m_type == TT_NORMAL);
+    if (!ETextureCompressor::Compress(m_pixels, m_width, m_height, m_channels, format, image)) {
+        EDebug::Log("Failed to compress texture - " + m_fileName, LT_WARNING);
+        return false;
+    }
+
+    compressedData->mipData = image.data.data();
+    m_compressedData = std::move(compressedData);
+    m_format = format;
+    m_mipCount = image.mipCount;
+
+    // The decoded image is no longer needed
+    stbi_image_free(m_pixels);
+    m_pixels = nullptr;
+    return true;
+}
+
+bool ETexture::SaveCookedTexture(const EString& cookedPath) const
+{
+    const ESCompressedImage& image = m_compressedData->image;
+
+    ESCookedTextureHeader header = {};
+    header.magic = ddsMagic;
+    header.size = sizeof(header) - sizeof(header.magic);
+    header.flags = ddsFlagCaps | ddsFlagHeight | ddsFlagWidth | ddsFlagPixelFormat | ddsFlagMipCount | ddsFlagLinearSize;
+    header.height = image.height;
+    header.width = image.width;
+    header.linearSize = (EUi32)ETextureCompressor::GetMipSize(image.format, image.width, image.height);
+    header.mipCount = image.mipCount;
+    header.engineMagic = cookedTextureMagic;
+    header.engineVersion = cookedTextureVersion;
+    header.pixelFormatSize = 32;
+    header.pixelFormatFlags = ddsPixelFormatFourCC;
+    header.fourCC = image.format == TF_BC1 ? ddsFourCCBC1 : image.format == TF_BC3 ? ddsFourCCBC3 : ddsFourCCBC5;
+    header.caps = ddsCapsComplex | ddsCapsTexture | ddsCapsMipMap;
+
+    if (!ESFileStamp::FromFile(m_path, header.source))
+        return false;
+
+    // Write to a temporary file first so a failed write never leaves a broken cooked texture
+    // Named by thread as textures with different sampler settings can cook the same file at once
+    const EString tempPath = cookedPath + "." + toEString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(image.data.data()), (std::streamsize)image.data.size());
+
+        if (!file) {
+            EDebug::Log("Failed to write cooked texture: " + cookedPath, LT_WARNING);
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, cookedPath, error);
+    if (error) {
+        EDebug::Log("Failed to write cooked texture: " + cookedPath + ": " + error.message(), LT_WARNING);
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    return true;
+}
+
+void ETexture::UploadCompressedMips()
+{
+    GLenum internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    if (m_format == TF_BC3)
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    else if (m_format == TF_BC5)
+        internalFormat = GL_COMPRESSED_RG_RGTC2;
+
+    // Only sample the levels that were uploaded
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)m_mipCount - 1);
+
+    const EUi8* mipData = m_compressedData->mipData;
+    EUi32 mipWidth = (EUi32)m_width;
+    EUi32 mipHeight = (EUi32)m_height;
+
+    for (EUi32 level = 0; level < m_mipCount; ++level) {
+        const size_t mipSize = ETextureCompressor::GetMipSize(m_format, mipWidth, mipHeight);
+        glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat,
+            (GLsizei)mipWidth, (GLsizei)mipHeight, 0, (GLsizei)mipSize, mipData);
+
+        mipData += mipSize;
+        mipWidth = std::max(mipWidth / 2, 1U);
+        mipHeight = std::max(mipHeight / 2, 1U);
+    }
+}
+
 void ETexture::BindTexture(const EUi32& textureNumber)
 {
     // Active texture in the shader
     glActiveTexture(GL_TEXTURE0 + textureNumber);
-    glBindTexture(GL_TEXTURE_2D, m_ID);
+
+    // Use the placeholder until the texture has uploaded
+    glBindTexture(GL_TEXTURE_2D, m_ID != 0 ? m_ID : s_placeholderID);
 }
 
 void ETexture::Unbind()
@@ -0,0 +1,492 @@
+#include "Graphics/ETextureCompressor.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// System Libs
+#include <algorithm>
+
+// Expand a 565 colour to 8 bits per channel the same way the GPU does
+static glm::ivec3 Unpack565(EUi16 colour)
+{
+	const int r = (colour >> 11) & 31;
+	const int g = (colour >> 5) & 63;
+	const int b = colour & 31;
+	return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+// Round a colour to the nearest 565 colour
+static EUi16 Pack565(const glm::vec3& colour)
+{
+	const glm::vec3 clamped = glm::clamp(colour, glm::vec3(0.0f), glm::vec3(255.0f));
+	const int r = (int)(clamped.r * 31.0f / 255.0f + 0.5f);
+	const int g = (int)(clamped.g * 63.0f / 255.0f + 0.5f);
+	const int b = (int)(clamped.b * 31.0f / 255.0f + 0.5f);
+	return (EUi16)((r << 11) | (g << 5) | b);
+}
+
+// Build the colour palette of a block
+// The block has 4 colours when colour0 is greater, otherwise 3 colours and black
+static void BuildColourPalette(EUi16 colour0, EUi16 colour1, glm::ivec3 palette[4])
+{
+	palette[0] = Unpack565(colour0);
+	palette[1] = Unpack565(colour1);
+
+	if (colour0 > colour1) {
+		palette[2] = (palette[0] * 2 + palette[1]) / 3;
+		palette[3] = (palette[0] + palette[1] * 2) / 3;
+	}
+	else {
+		palette[2] = (palette[0] + palette[1]) / 2;
+		palette[3] = glm::ivec3(0);
+	}
+}
+
+// Order the end points for 4 colours and pick the closest palette colour for each pixel
+// Returns the squared error of the block
+static EUi32 FitColourIndices(const EUi8* rgba, EUi16& colour0, EUi16& colour1, EUi32& indices)
+{
+	if (colour0 < colour1)
+		std::swap(colour0, colour1);
+
+	glm::ivec3 palette[4];
+	BuildColourPalette(colour0, colour1, palette);
+
+	// Equal end points can only use the first colour, BC3 always reads the block as 4 colours
+	const EUi32 paletteSize = colour0 == colour1 ? 1 : 4;
+
+	EUi32 error = 0;
+	indices = 0;
+
+	for (EUi32 i = 0; i < 16; ++i) {
+		const glm::ivec3 pixel(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+
+		EUi32 bestIndex = 0;
+		EUi32 bestError = 0xFFFFFFFF;
+		for (EUi32 j = 0; j < paletteSize; ++j) {
+			const glm::ivec3 delta = pixel - palette[j];
+			const EUi32 pixelError = (EUi32)(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+			if (pixelError < bestError) {
+				bestError = pixelError;
+				bestIndex = j;
+			}
+		}
+
+		error += bestError;
+		indices |= bestIndex << (i * 2);
+	}
+
+	return error;
+}
+
+size_t ETextureCompressor::GetMipSize(EETextureFormat format, EUi32 width, EUi32 height)
+{
+	return (size_t)((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+size_t ETextureCompressor::GetImageSize(EETextureFormat format, EUi32 width, EUi32 height, EUi32 mipCount)
+{
+	size_t size = 0;
+	for (EUi32 i = 0; i < mipCount; ++i) {
+		size += GetMipSize(format, width, height);
+		width = std::max(width / 2, 1U);
+		height = std::max(height / 2, 1U);
+	}
+
+	return size;
+}
+
+EUi32 ETextureCompressor::GetMipCount(EUi32 width, EUi32 height)
+{
+	EUi32 mipCount = 1;
+	while (width > 1 || height > 1) {
+		width = std::max(width / 2, 1U);
+		height = std::max(height / 2, 1U);
+		++mipCount;
+	}
+
+	return mipCount;
+}
+
+EETextureFormat ETextureCompressor::ChooseFormat(const EUi8* pixels, EUi32 width, EUi32 height, int channels, bool normalMap)
+{
+	if (normalMap)
+		return TF_BC5;
+
+	// Only pay for the alpha block when the alpha is used
+	if (channels == 4) {
+		const size_t pixelCount = (size_t)width * height;
+		for (size_t i = 0; i < pixelCount; ++i) {
+			if (pixels[i * 4 + 3] != 255)
+				return TF_BC3;
+		}
+	}
+
+	return TF_BC1;
+}
+
+bool ETextureCompressor::Compress(const EUi8* pixels, EUi32 width, EUi32 height, int channels,
+	EETextureFormat format, ESCompressedImage& image)
+{
+	if (pixels == nullptr || width == 0 || height == 0 || channels < 3 || channels > 4 || format == TF_UNCOMPRESSED)
+		return false;
+
+	image.format = format;
+	image.width = width;
+	image.height = height;
+	image.mipCount = GetMipCount(width, height);
+	image.data.assign(GetImageSize(format, width, height, image.mipCount), 0);
+
+	// Work in RGBA so every format reads the pixels the same way
+	TArray<EUi8> mip((size_t)width * height * 4);
+	for (size_t i = 0; i < (size_t)width * height; ++i) {
+		mip[i * 4] = pixels[i * channels];
+		mip[i * 4 + 1] = pixels[i * channels + 1];
+		mip[i * 4 + 2] = pixels[i * channels + 2];
+		mip[i * 4 + 3] = channels == 4 ? pixels[i * channels + 3] : 255;
+	}
+
+	TArray<EUi8> nextMip;
+	EUi32 mipWidth = width;
+	EUi32 mipHeight = height;
+	EUi8* block = image.data.data();
+	const EUi32 blockSize = GetBlockSize(format);
+
+	for (EUi32 level = 0; level < image.mipCount; ++level) {
+		for (EUi32 blockY = 0; blockY < mipHeight; blockY += 4) {
+			for (EUi32 blockX = 0; blockX < mipWidth; blockX += 4) {
+				// Blocks past the edge of the image repeat the edge pixels
+				EUi8 blockPixels[64];
+				for (EUi32 y = 0; y < 4; ++y) {
+					for (EUi32 x = 0; x < 4; ++x) {
+						const EUi32 sourceX = std::min(blockX + x, mipWidth - 1);
+						const EUi32 sourceY = std::min(blockY + y, mipHeight - 1);
+						const EUi8* source = &mip[((size_t)sourceY * mipWidth + sourceX) * 4];
+						std::copy(source, source + 4, &blockPixels[(y * 4 + x) * 4]);
+					}
+				}
+
+				EncodeBlock(format, blockPixels, block);
+				block += blockSize;
+			}
+		}
+
+		if (level + 1 < image.mipCount) {
+			DownsampleMip(mip, mipWidth, mipHeight, nextMip, format == TF_BC5);
+			mip.swap(nextMip);
+			mipWidth = std::max(mipWidth / 2, 1U);
+			mipHeight = std::max(mipHeight / 2, 1U);
+		}
+	}
+
+	return true;
+}
+
+void ETextureCompressor::EncodeBlock(EETextureFormat format, const EUi8* rgba, EUi8* block)
+{
+	switch (format) {
+	case TF_BC1:
+		EncodeColourBlock(rgba, block);
+		break;
+	case TF_BC3:
+		EncodeChannelBlock(rgba, 3, block);
+		EncodeColourBlock(rgba, block + 8);
+		break;
+	case TF_BC5:
+		EncodeChannelBlock(rgba, 0, block);
+		EncodeChannelBlock(rgba, 1, block + 8);
+		break;
+	default:
+		break;
+	}
+}
+
+void ETextureCompressor::DecodeBlock(EETextureFormat format, const EUi8* block, EUi8* rgba)
+{
+	switch (format) {
+	case TF_BC1:
+		DecodeColourBlock(block, rgba);
+		break;
+	case TF_BC3:
+		DecodeColourBlock(block + 8, rgba);
+		DecodeChannelBlock(block, 3, rgba);
+		break;
+	case TF_BC5:
+		for (EUi32 i = 0; i < 16; ++i) {
+			rgba[i * 4 + 2] = 0;
+			rgba[i * 4 + 3] = 255;
+		}
+		DecodeChannelBlock(block, 0, rgba);
+		DecodeChannelBlock(block + 8, 1, rgba);
+		break;
+	default:
+		break;
+	}
+}
+
+void ETextureCompressor::DecodeMip(EETextureFormat format, const EUi8* data, EUi32 width, EUi32 height, TArray<EUi8>& rgba)
+{
+	rgba.assign((size_t)width * height * 4, 0);
+	const EUi32 blockSize = GetBlockSize(format);
+
+	for (EUi32 blockY = 0; blockY < height; blockY += 4) {
+		for (EUi32 blockX = 0; blockX < width; blockX += 4) {
+			EUi8 blockPixels[64];
+			DecodeBlock(format, data, blockPixels);
+			data += blockSize;
+
+			// Drop the pixels past the edge of the image
+			for (EUi32 y = 0; y < 4 && blockY + y < height; ++y) {
+				for (EUi32 x = 0; x < 4 && blockX + x < width; ++x) {
+					const EUi8* source = &blockPixels[(y * 4 + x) * 4];
+					std::copy(source, source + 4, &rgba[((size_t)(blockY + y) * width + blockX + x) * 4]);
+				}
+			}
+		}
+	}
+}
+
+void ETextureCompressor::EncodeColourBlock(const EUi8* rgba, EUi8* block)
+{
+	glm::vec3 mean(0.0f);
+	glm::vec3 minColour(255.0f);
+	glm::vec3 maxColour(0.0f);
+	for (EUi32 i = 0; i < 16; ++i) {
+		const glm::vec3 pixel(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+		mean += pixel;
+		minColour = glm::min(minColour, pixel);
+		maxColour = glm::max(maxColour, pixel);
+	}
+	mean /= 16.0f;
+
+	EUi16 colour0 = Pack565(maxColour);
+	EUi16 colour1 = Pack565(minColour);
+
+	// The end points lie on the main axis of the colours
+	// Found with a few power iterations on the covariance
+	const glm::vec3 range = maxColour - minColour;
+	if (glm::dot(range, range) > 0.0f) {
+		glm::mat3 covariance(0.0f);
+		for (EUi32 i = 0; i < 16; ++i) {
+			const glm::vec3 offset = glm::vec3(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]) - mean;
+			covariance += glm::outerProduct(offset, offset);
+		}
+
+		// Start from the covariance of the channel that varies most
+		// The colour range is perpendicular to the main axis when channels go in opposite directions
+		int largestChannel = 0;
+		for (int channel = 1; channel < 3; ++channel) {
+			if (covariance[channel][channel] > covariance[largestChannel][largestChannel])
+				largestChannel = channel;
+		}
+
+		glm::vec3 axis = covariance[largestChannel];
+
+		for (EUi32 i = 0; i < 4; ++i) {
+			const glm::vec3 nextAxis = covariance * axis;
+			const float largest = std::max({ std::abs(nextAxis.x), std::abs(nextAxis.y), std::abs(nextAxis.z) });
+			if (largest <= 0.0f)
+				break;
+
+			axis = nextAxis / largest;
+		}
+
+		axis = glm::normalize(axis);
+
+		float minProjection = 0.0f;
+		float maxProjection = 0.0f;
+		for (EUi32 i = 0; i < 16; ++i) {
+			const float projection = glm::dot(glm::vec3(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]) - mean, axis);
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		colour0 = Pack565(mean + axis * maxProjection);
+		colour1 = Pack565(mean + axis * minProjection);
+	}
+
+	EUi32 indices = 0;
+	EUi32 error = FitColourIndices(rgba, colour0, colour1, indices);
+
+	// Move the end points to the least squares fit of the chosen indices and keep them if the error drops
+	// Weight of colour0 for each index, colour1 has the rest
+	const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+	for (EUi32 pass = 0; pass < 2 && error > 0; ++pass) {
+		float weight00 = 0.0f, weight11 = 0.0f, weight01 = 0.0f;
+		glm::vec3 colour0Sum(0.0f), colour1Sum(0.0f);
+
+		for (EUi32 i = 0; i < 16; ++i) {
+			const glm::vec3 pixel(rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2]);
+			const float weight0 = weights[(indices >> (i * 2)) & 3];
+			const float weight1 = 1.0f - weight0;
+
+			weight00 += weight0 * weight0;
+			weight11 += weight1 * weight1;
+			weight01 += weight0 * weight1;
+			colour0Sum += pixel * weight0;
+			colour1Sum += pixel * weight1;
+		}
+
+		const float determinant = weight00 * weight11 - weight01 * weight01;
+		if (std::abs(determinant) < 1e-6f)
+			break;
+
+		EUi16 refined0 = Pack565((colour0Sum * weight11 - colour1Sum * weight01) / determinant);
+		EUi16 refined1 = Pack565((colour1Sum * weight00 - colour0Sum * weight01) / determinant);
+
+		EUi32 refinedIndices = 0;
+		const EUi32 refinedError = FitColourIndices(rgba, refined0, refined1, refinedIndices);
+		if (refinedError >= error)
+			break;
+
+		colour0 = refined0;
+		colour1 = refined1;
+		indices = refinedIndices;
+		error = refinedError;
+	}
+
+	block[0] = (EUi8)(colour0 & 0xFF);
+	block[1] = (EUi8)(colour0 >> 8);
+	block[2] = (EUi8)(colour1 & 0xFF);
+	block[3] = (EUi8)(colour1 >> 8);
+	block[4] = (EUi8)(indices & 0xFF);
+	block[5] = (EUi8)((indices >> 8) & 0xFF);
+	block[6] = (EUi8)((indices >> 16) & 0xFF);
+	block[7] = (EUi8)(indices >> 24);
+}
+
+void ETextureCompressor::EncodeChannelBlock(const EUi8* rgba, int channel, EUi8* block)
+{
+	int lowest = 255;
+	int highest = 0;
+	for (EUi32 i = 0; i < 16; ++i) {
+		lowest = std::min(lowest, (int)rgba[i * 4 + channel]);
+		highest = std::max(highest, (int)rgba[i * 4 + channel]);
+	}
+
+	std::fill(block, block + 8, (EUi8)0);
+	block[0] = (EUi8)highest;
+	block[1] = (EUi8)lowest;
+
+	// A flat block uses the first value for every pixel
+	if (highest == lowest)
+		return;
+
+	// The first value is higher so the block has 8 values between the end points
+	int palette[8] = { highest, lowest };
+	for (int i = 2; i < 8; ++i) {
+		palette[i] = ((8 - i) * highest + (i - 1) * lowest) / 7;
+	}
+
+	EUi64 indices = 0;
+	for (EUi32 i = 0; i < 16; ++i) {
+		const int value = rgba[i * 4 + channel];
+
+		EUi64 bestIndex = 0;
+		int bestError = 256;
+		for (int j = 0; j < 8; ++j) {
+			const int valueError = std::abs(value - palette[j]);
+			if (valueError < bestError) {
+				bestError = valueError;
+				bestIndex = (EUi64)j;
+			}
+		}
+
+		indices |= bestIndex << (i * 3);
+	}
+
+	for (EUi32 i = 0; i < 6; ++i) {
+		block[2 + i] = (EUi8)((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void ETextureCompressor::DecodeColourBlock(const EUi8* block, EUi8* rgba)
+{
+	const EUi16 colour0 = (EUi16)(block[0] | (block[1] << 8));
+	const EUi16 colour1 = (EUi16)(block[2] | (block[3] << 8));
+	const EUi32 indices = (EUi32)block[4] | ((EUi32)block[5] << 8) | ((EUi32)block[6] << 16) | ((EUi32)block[7] << 24);
+
+	glm::ivec3 palette[4];
+	BuildColourPalette(colour0, colour1, palette);
+
+	for (EUi32 i = 0; i < 16; ++i) {
+		const glm::ivec3& colour = palette[(indices >> (i * 2)) & 3];
+		rgba[i * 4] = (EUi8)colour.r;
+		rgba[i * 4 + 1] = (EUi8)colour.g;
+		rgba[i * 4 + 2] = (EUi8)colour.b;
+		rgba[i * 4 + 3] = 255;
+	}
+}
+
+void ETextureCompressor::DecodeChannelBlock(const EUi8* block, int channel, EUi8* rgba)
+{
+	const int value0 = block[0];
+	const int value1 = block[1];
+
+	int palette[8] = { value0, value1 };
+	if (value0 > value1) {
+		for (int i = 2; i < 8; ++i) {
+			palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+		}
+	}
+	else {
+		for (int i = 2; i < 6; ++i) {
+			palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	EUi64 indices = 0;
+	for (EUi32 i = 0; i < 6; ++i) {
+		indices |= (EUi64)block[2 + i] << (i * 8);
+	}
+
+	for (EUi32 i = 0; i < 16; ++i) {
+		rgba[i * 4 + channel] = (EUi8)palette[(indices >> (i * 3)) & 7];
+	}
+}
+
+void ETextureCompressor::DownsampleMip(const TArray<EUi8>& source, EUi32 width, EUi32 height,
+	TArray<EUi8>& mip, bool normalMap)
+{
+	const EUi32 mipWidth = std::max(width / 2, 1U);
+	const EUi32 mipHeight = std::max(height / 2, 1U);
+	mip.resize((size_t)mipWidth * mipHeight * 4);
+
+	for (EUi32 y = 0; y < mipHeight; ++y) {
+		for (EUi32 x = 0; x < mipWidth; ++x) {
+			// The 2x2 pixels under the mip pixel, clamped for 1 pixel wide images
+			const EUi32 x0 = std::min(x * 2, width - 1);
+			const EUi32 x1 = std::min(x * 2 + 1, width - 1);
+			const EUi32 y0 = std::min(y * 2, height - 1);
+			const EUi32 y1 = std::min(y * 2 + 1, height - 1);
+			const EUi8* samples[4] = {
+				&source[((size_t)y0 * width + x0) * 4], &source[((size_t)y0 * width + x1) * 4],
+				&source[((size_t)y1 * width + x0) * 4], &source[((size_t)y1 * width + x1) * 4]
+			};
+
+			EUi8* pixel = &mip[((size_t)y * mipWidth + x) * 4];
+
+			for (EUi32 channel = 0; channel < 4; ++channel) {
+				const int sum = samples[0][channel] + samples[1][channel] + samples[2][channel] + samples[3][channel];
+				pixel[channel] = (EUi8)((sum + 2) / 4);
+			}
+
+			// Averaged normals are shorter than 1, scale them back so lighting doesn't dim on distant surfaces
+			if (normalMap) {
+				glm::vec3 normal(0.0f);
+				for (const EUi8* sample : samples) {
+					normal += glm::vec3(sample[0], sample[1], sample[2]) / 127.5f - 1.0f;
+				}
+
+				if (glm::dot(normal, normal) > 0.0f) {
+					normal = glm::normalize(normal);
+					for (EUi32 channel = 0; channel < 3; ++channel) {
+						pixel[channel] = (EUi8)glm::clamp((normal[channel] + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#include "IO/ESFileStamp.h"
+#include "IO/EMappedFile.h"
+
+// System Libs
+#include <filesystem>
+
+// Read the size and write time of a file without reading its contents
+static bool ReadFileInfo(const EString& path, EUi64& size, EUi64& writeTime)
+{
+	std::error_code error;
+	size = (EUi64)std::filesystem::file_size(path, error);
+	if (error)
+		return false;
+
+	writeTime = (EUi64)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+	return !error;
+}
+
+bool ESFileStamp::FromFile(const EString& path, ESFileStamp& stamp)
+{
+	if (!ReadFileInfo(path, stamp.size, stamp.writeTime))
+		return false;
+
+	EMappedFile file;
+	if (!file.Open(path))
+		return false;
+
+	stamp.hash = HashBytes(file.GetData(), file.GetSize());
+	return true;
+}
+
+EUi64 ESFileStamp::HashBytes(const EUi8* data, size_t size)
+{
+	EUi64 hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+bool ESFileStamp::Matches(const EString& path) const
+{
+	EUi64 fileSize = 0, fileWriteTime = 0;
+	if (!ReadFileInfo(path, fileSize, fileWriteTime) || fileSize != size)
+		return false;
+
+	if (fileWriteTime == writeTime)
+		return true;
+
+	// The file was written but may not have changed
+	EMappedFile file;
+	return file.Open(path) && HashBytes(file.GetData(), file.GetSize()) == hash;
+}
@@ -0,0 +1,249 @@
+#include "Math/ESpatialHash.h"
+
+// System Libs
+#include <algorithm>
+#include <cmath>
+
+ESpatialHash::ESpatialHash(float cellSize, EUi32 maxCellsPerBox)
+{
+	m_cellSize = cellSize;
+	m_invCellSize = 1.0f / cellSize;
+	m_maxCellsPerBox = maxCellsPerBox;
+	m_bucketMask = 0;
+}
+
+void ESpatialHash::Clear()
+{
+	m_boxes.clear();
+	m_largeBoxes.clear();
+	m_entries.clear();
+	m_packedPairs.clear();
+	m_pairs.clear();
+}
+
+void ESpatialHash::Insert(const ESBox& box, EUi32 ownerID)
+{
+	// Zero sized boxes can never overlap so skip them
+	if (box.halfSize == glm::vec3(0.0f))
+		return;
+
+	ESHashBox hashBox;
+	hashBox.box = box;
+	hashBox.ownerID = ownerID;
+	hashBox.minCell = GetCell(box.GetMin());
+	hashBox.maxCell = GetCell(box.GetMax());
+
+	m_boxes.push_back(hashBox);
+}
+
+void ESpatialHash::Build()
+{
+	m_entries.clear();
+	m_largeBoxes.clear();
+
+	// Count the cells each box touches, large boxes skip the grid
+	EUi64 cellCount = 0;
+	for (EUi32 i = 0; i < m_boxes.size(); ++i) {
+		if (IsLargeBox(m_boxes[i])) {
+			m_largeBoxes.push_back(i);
+			continue;
+		}
+
+		const glm::ivec3 span = m_boxes[i].maxCell - m_boxes[i].minCell + 1;
+		cellCount += (EUi64)span.x * (EUi64)span.y * (EUi64)span.z;
+	}
+
+	// Use twice as many buckets as entries to keep buckets short
+	EUi32 bucketCount = 1;
+	while (bucketCount < cellCount * 2)
+		bucketCount <<= 1;
+	m_bucketMask = bucketCount - 1;
+
+	// Count the entries per bucket
+	m_bucketStarts.assign(bucketCount + 1, 0);
+	for (EUi32 i = 0; i < m_boxes.size(); ++i) {
+		const ESHashBox& hashBox = m_boxes[i];
+		if (IsLargeBox(hashBox))
+			continue;
+
+		for (int x = hashBox.minCell.x; x <= hashBox.maxCell.x; ++x)
+			for (int y = hashBox.minCell.y; y <= hashBox.maxCell.y; ++y)
+				for (int z = hashBox.minCell.z; z <= hashBox.maxCell.z; ++z)
+					++m_bucketStarts[HashCell({ x, y, z }) + 1];
+	}
+
+	// Convert the counts into bucket start offsets
+	for (EUi32 i = 1; i <= bucketCount; ++i)
+		m_bucketStarts[i] += m_bucketStarts[i - 1];
+
+	// Fill the buckets, each start is moved to the end of its bucket while filling
+	m_entries.resize(cellCount);
+	for (EUi32 i = 0; i < m_boxes.size(); ++i) {
+		const ESHashBox& hashBox = m_boxes[i];
+		if (IsLargeBox(hashBox))
+			continue;
+
+		for (int x = hashBox.minCell.x; x <= hashBox.maxCell.x; ++x)
+			for (int y = hashBox.minCell.y; y <= hashBox.maxCell.y; ++y)
+				for (int z = hashBox.minCell.z; z <= hashBox.maxCell.z; ++z) {
+					const glm::ivec3 cell = { x, y, z };
+					m_entries[m_bucketStarts[HashCell(cell)]++] = { cell, i };
+				}
+	}
+
+	// Undo the shift from the fill so each start points at its bucket again
+	for (EUi32 i = bucketCount; i > 0; --i)
+		m_bucketStarts[i] = m_bucketStarts[i - 1];
+	m_bucketStarts[0] = 0;
+}
+
+const TArray<std::pair<EUi32, EUi32>>& ESpatialHash::FindPairs()
+{
+	m_packedPairs.clear();
+	m_pairs.clear();
+
+	Build();
+
+	const EUi32 bucketCount = m_bucketMask + 1;
+
+	// Pair every box that shares a cell within each bucket
+	for (EUi32 bucket = 0; bucket < bucketCount; ++bucket) {
+		const EUi32 start = m_bucketStarts[bucket];
+		const EUi32 end = m_bucketStarts[bucket + 1];
+
+		for (EUi32 i = start; i < end; ++i) {
+			for (EUi32 j = i + 1; j < end; ++j) {
+				const ESHashEntry& a = m_entries[i];
+				const ESHashEntry& b = m_entries[j];
+
+				// Different cells can hash into the same bucket
+				if (a.cell != b.cell)
+					continue;
+
+				const ESHashBox& boxA = m_boxes[a.boxIndex];
+				const ESHashBox& boxB = m_boxes[b.boxIndex];
+
+				if (boxA.ownerID == boxB.ownerID)
+					continue;
+
+				// Only report the pair from the first cell both boxes share
+				// Stops boxes that share many cells being reported many times
+				if (glm::max(boxA.minCell, boxB.minCell) != a.cell)
+					continue;
+
+				AddPair(boxA.ownerID, boxB.ownerID);
+			}
+		}
+	}
+
+	// Large boxes are tested against every other box
+	for (EUi32 i = 0; i < m_largeBoxes.size(); ++i) {
+		const ESHashBox& largeBox = m_boxes[m_largeBoxes[i]];
+
+		for (EUi32 j = 0; j < m_boxes.size(); ++j) {
+			// Large boxes are paired with each other once
+			if (j <= m_largeBoxes[i] && std::binary_search(m_largeBoxes.begin(), m_largeBoxes.end(), j))
+				continue;
+
+			const ESHashBox& otherBox = m_boxes[j];
+
+			if (largeBox.ownerID == otherBox.ownerID)
+				continue;
+
+			// Only pair boxes whose cell ranges overlap
+			if (glm::any(glm::lessThan(largeBox.maxCell, otherBox.minCell)) ||
+				glm::any(glm::greaterThan(largeBox.minCell, otherBox.maxCell)))
+				continue;
+
+			AddPair(largeBox.ownerID, otherBox.ownerID);
+		}
+	}
+
+	// Owners with more than one box can be paired more than once
+	std::sort(m_packedPairs.begin(), m_packedPairs.end());
+	m_packedPairs.erase(std::unique(m_packedPairs.begin(), m_packedPairs.end()), m_packedPairs.end());
+
+	// Unpack into owner pairs
+	m_pairs.reserve(m_packedPairs.size());
+	for (const EUi64 packed : m_packedPairs) {
+		m_pairs.push_back({ (EUi32)(packed >> 32), (EUi32)(packed & 0xFFFFFFFF) });
+	}
+
+	return m_pairs;
+}
+
+void ESpatialHash::Query(const ESBox& box, TArray<EUi32>& owners) const
+{
+	const size_t firstOwner = owners.size();
+	const glm::ivec3 minCell = GetCell(box.GetMin());
+	const glm::ivec3 maxCell = GetCell(box.GetMax());
+	const glm::ivec3 span = maxCell - minCell + 1;
+
+	// Large query boxes test every box by cell range instead of visiting every cell
+	if ((EUi64)span.x * (EUi64)span.y * (EUi64)span.z > m_maxCellsPerBox) {
+		for (const ESHashBox& hashBox : m_boxes) {
+			if (glm::any(glm::lessThan(maxCell, hashBox.minCell)) ||
+				glm::any(glm::greaterThan(minCell, hashBox.maxCell)))
+				continue;
+
+			owners.push_back(hashBox.ownerID);
+		}
+	}
+	else {
+		// Boxes in the same cell as the query box
+		if (!m_entries.empty()) {
+			for (int x = minCell.x; x <= maxCell.x; ++x)
+				for (int y = minCell.y; y <= maxCell.y; ++y)
+					for (int z = minCell.z; z <= maxCell.z; ++z) {
+						const glm::ivec3 cell = { x, y, z };
+						const EUi32 bucket = HashCell(cell);
+
+						for (EUi32 i = m_bucketStarts[bucket]; i < m_bucketStarts[bucket + 1]; ++i) {
+							if (m_entries[i].cell == cell)
+								owners.push_back(m_boxes[m_entries[i].boxIndex].ownerID);
+						}
+					}
+		}
+
+		// Large boxes whose cell range covers the query box
+		for (const EUi32 largeIndex : m_largeBoxes) {
+			const ESHashBox& hashBox = m_boxes[largeIndex];
+			if (glm::any(glm::lessThan(maxCell, hashBox.minCell)) ||
+				glm::any(glm::greaterThan(minCell, hashBox.maxCell)))
+				continue;
+
+			owners.push_back(hashBox.ownerID);
+		}
+	}
+
+	// Boxes that cover many cells or owners with many boxes are found more than once
+	std::sort(owners.begin() + firstOwner, owners.end());
+	owners.erase(std::unique(owners.begin() + firstOwner, owners.end()), owners.end());
+}
+
+glm::ivec3 ESpatialHash::GetCell(const glm::vec3& position) const
+{
+	return glm::ivec3(glm::floor(position * m_invCellSize));
+}
+
+EUi32 ESpatialHash::HashCell(const glm::ivec3& cell) const
+{
+	// Large primes to spread neighbouring cells across buckets
+	const EUi32 hash = ((EUi32)cell.x * 73856093U) ^ ((EUi32)cell.y * 19349663U) ^ ((EUi32)cell.z * 83492791U);
+	return hash & m_bucketMask;
+}
+
+bool ESpatialHash::IsLargeBox(const ESHashBox& hashBox) const
+{
+	const glm::ivec3 span = hashBox.maxCell - hashBox.minCell + 1;
+	return (EUi64)span.x * (EUi64)span.y * (EUi64)span.z > m_maxCellsPerBox;
+}
+
+void ESpatialHash::AddPair(EUi32 ownerA, EUi32 ownerB)
+{
+	// Always store the lower id first so duplicates sort together
+	if (ownerA > ownerB)
+		std::swap(ownerA, ownerB);
+
+	m_packedPairs.push_back(((EUi64)ownerA << 32) | (EUi64)ownerB);
+}
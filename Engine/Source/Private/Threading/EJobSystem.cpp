@@ -0,0 +1,191 @@
+#include "Threading/EJobSystem.h"
+
+// System Libs
+#include <algorithm>
+
+// Index of the worker on this thread, threads not owned by the job system are 0
+static thread_local EUi32 s_workerIndex = 0;
+
+EJobSystem::EJobSystem(EUi32 threadCount)
+{
+	m_queuedJobs = 0;
+	m_shuttingDown = false;
+
+	// Leave a core for the calling thread
+	if (threadCount == 0) {
+		const EUi32 cores = std::thread::hardware_concurrency();
+		threadCount = cores > 1 ? cores - 1 : 0;
+	}
+
+	// Create a queue for the calling thread and every worker
+	for (EUi32 i = 0; i <= threadCount; ++i) {
+		m_queues.push_back(TMakeUnique<ESJobQueue>());
+	}
+
+	// Start the workers
+	for (EUi32 i = 1; i <= threadCount; ++i) {
+		m_threads.emplace_back(&EJobSystem::WorkerLoop, this, i);
+	}
+
+	EDebug::Log("Job system started with " + std::to_string(threadCount) + " worker threads");
+}
+
+EJobSystem::~EJobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_shuttingDown = true;
+	}
+	m_wakeCondition.notify_all();
+
+	for (std::thread& thread : m_threads) {
+		thread.join();
+	}
+}
+
+void EJobSystem::ParallelFor(EUi32 count, EUi32 minChunkSize, const EJobFunc& func)
+{
+	if (count == 0)
+		return;
+
+	// Aim for a few chunks per worker so stealing can even out uneven chunks
+	const EUi32 workerCount = GetWorkerCount();
+	const EUi32 chunkSize = std::max(std::max(minChunkSize, 1U), (count + workerCount * 4 - 1) / (workerCount * 4));
+	const EUi32 chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	// Not worth waking the workers for one chunk
+	if (workerCount == 1 || chunkCount == 1) {
+		func(0, count);
+		return;
+	}
+
+	std::atomic<EUi32> remaining = chunkCount;
+
+	// Count the jobs before they are queued so a worker never sees more jobs than were counted
+	m_queuedJobs += chunkCount;
+
+	// Deal the chunks out to every queue
+	for (EUi32 chunk = 0; chunk < chunkCount; ++chunk) {
+		ESJob job;
+		job.func = &func;
+		job.begin = chunk * chunkSize;
+		job.end = std::min(job.begin + chunkSize, count);
+		job.remaining = &remaining;
+
+		ESJobQueue& queue = *m_queues[chunk % workerCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+
+	// Wake the sleeping workers
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_wakeCondition.notify_all();
+
+	// Work on the jobs until they are all done
+	const EUi32 workerIndex = GetWorkerIndex();
+	while (remaining.load(std::memory_order_acquire) > 0) {
+		if (!RunJob(workerIndex)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void EJobSystem::Schedule(const ETaskFunc& task)
+{
+	if (m_threads.empty()) {
+		task();
+		return;
+	}
+
+	// Count the task before it is queued so a worker never sees more jobs than were counted
+	++m_queuedJobs;
+
+	{
+		std::lock_guard<std::mutex> lock(m_taskMutex);
+		m_tasks.push_back(task);
+	}
+
+	// Wake a sleeping worker
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_wakeCondition.notify_one();
+}
+
+EUi32 EJobSystem::GetWorkerIndex()
+{
+	return s_workerIndex;
+}
+
+void EJobSystem::WorkerLoop(EUi32 workerIndex)
+{
+	s_workerIndex = workerIndex;
+
+	while (!m_shuttingDown) {
+		if (RunJob(workerIndex))
+			continue;
+
+		// Sleep until more jobs are queued
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wakeCondition.wait(lock, [this]() { return m_shuttingDown || m_queuedJobs > 0; });
+	}
+}
+
+bool EJobSystem::RunJob(EUi32 workerIndex)
+{
+	ESJob job;
+	bool found = false;
+
+	// Take the newest job from our own queue first
+	{
+		ESJobQueue& queue = *m_queues[workerIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+			found = true;
+		}
+	}
+
+	// Steal the oldest job from the other queues
+	for (EUi32 i = 1; !found && i < m_queues.size(); ++i) {
+		ESJobQueue& queue = *m_queues[(workerIndex + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+			found = true;
+		}
+	}
+
+	// Only worker threads run background tasks, they can be slow
+	if (!found && workerIndex != 0) {
+		ETaskFunc task;
+		{
+			std::lock_guard<std::mutex> lock(m_taskMutex);
+			if (!m_tasks.empty()) {
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+		}
+
+		if (task) {
+			--m_queuedJobs;
+			task();
+			return true;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	--m_queuedJobs;
+
+	(*job.func)(job.begin, job.end);
+
+	job.remaining->fetch_sub(1, std::memory_order_release);
+
+	return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "EngineTypes.h"
+
+// Standalone benchmarks that run without the game window
+// Launch the engine with -bench <name> to run one
+class EBenchmark {
+public:
+	// Run a benchmark by name, returns false if no benchmark matches or its checks failed
+	static bool Run(const EString& name);
+
+	// Time the collision broadphase and narrowphase from 100 to 20k colliders
+	static void RunCollisionBenchmark();
+
+	// Time the CPU cost of setting the uniforms of each mesh draw with name lookups against cached locations
+	// Opens a hidden window for an OpenGL context
+	static void RunDrawBenchmark();
+
+	// Import every model in the Models folder and compare the vertex cache miss ratio
+	// of the faces as stored in the file against the import optimisation
+	static void RunMeshBenchmark();
+
+	// Compress every image in the Textures and Models folders
+	// Compares the memory, error and time of the block compression against the decoded images
+	static void RunTextureBenchmark();
+
+	// Check the block compressor on the CPU, no GPU needed
+	// Round trips solid and gradient blocks, checks the PSNR of a smooth image and that normal map mips stay unit length
+	// Returns false if any check failed, failures are logged as errors
+	static bool RunCompressorChecks();
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include "EngineTypes.h"
+
+// Profiling is on in debug builds and compiled out in release builds
+// Define EPROFILING_ENABLED as 1 to profile a release build
+#ifndef EPROFILING_ENABLED
+#ifdef NDEBUG
+#define EPROFILING_ENABLED 0
+#else
+#define EPROFILING_ENABLED 1
+#endif
+#endif
+
+#if EPROFILING_ENABLED
+
+// System Libs
+#include <atomic>
+
+// A timed zone recorded by the profiler
+struct ESProfileEvent {
+	// Name of the zone, must be a string that lives forever such as a literal
+	const char* name = nullptr;
+
+	// Start and end time in nanoseconds
+	EUi64 start = 0;
+	EUi64 end = 0;
+};
+
+// Events recorded by one thread
+// Only the owning thread writes and only the main thread reads so no locks are needed
+class EProfileRingBuffer {
+public:
+	// Most events the buffer can hold before it drops new events
+	static constexpr EUi32 capacity = 16384;
+
+	EProfileRingBuffer(EUi32 threadID);
+
+	// Add an event to the buffer, dropped if the buffer is full
+	void Push(const ESProfileEvent& event);
+
+	// Remove the oldest event from the buffer, returns false if empty
+	bool Pop(ESProfileEvent& event);
+
+	// Get the id of the thread that owns the buffer
+	EUi32 GetThreadID() const { return m_threadID; }
+
+	// Get the number of events dropped because the buffer was full
+	EUi64 GetDroppedCount() const { return m_dropped; }
+
+private:
+	// Events stored in a circle
+	ESProfileEvent m_events[capacity];
+
+	// Count of events written, only changed by the owning thread
+	std::atomic<EUi32> m_head;
+
+	// Count of events read, only changed by the main thread
+	std::atomic<EUi32> m_tail;
+
+	// Events dropped because the buffer was full
+	std::atomic<EUi64> m_dropped;
+
+	// Id of the thread that owns the buffer
+	EUi32 m_threadID;
+};
+
+// CPU timing zones for finding where a frame goes
+// Use EPROFILE_ZONE to time a scope, the macros compile out when profiling is disabled
+class EProfiler {
+public:
+	// Get the current time in nanoseconds
+	static EUi64 Now();
+
+	// Record a zone on the calling thread
+	static void Record(const char* name, EUi64 start, EUi64 end);
+
+	// Collect the zones from every thread, run once per frame on the main thread
+	static void EndFrame();
+
+	// Log the min, average and 99th percentile of each zone over the last few seconds
+	static void LogSummary();
+
+	// Start keeping every zone for a trace
+	static void BeginCapture();
+
+	// Stop the capture and write it as chrome trace_event json
+	// Open in chrome://tracing or ui.perfetto.dev
+	static bool EndCapture(const EString& path);
+
+	// Check if a capture is running
+	static bool IsCapturing();
+
+private:
+	// Get the ring buffer for the calling thread, creates it on first use
+	static EProfileRingBuffer& GetThreadBuffer();
+};
+
+// Times the scope it is created in
+class EProfileZone {
+public:
+	EProfileZone(const char* name) : m_name(name), m_start(EProfiler::Now()) {}
+	~EProfileZone() { EProfiler::Record(m_name, m_start, EProfiler::Now()); }
+
+private:
+	const char* m_name;
+	EUi64 m_start;
+};
+
+#define EPROFILE_CONCAT_INNER(a, b) a##b
+#define EPROFILE_CONCAT(a, b) EPROFILE_CONCAT_INNER(a, b)
+
+// Time the rest of the scope, name must be a string literal
+#define EPROFILE_ZONE(name) EProfileZone EPROFILE_CONCAT(profileZone, __LINE__)(name)
+
+// Collect the zones recorded this frame
+#define EPROFILE_END_FRAME() EProfiler::EndFrame()
+
+#else
+
+#define EPROFILE_ZONE(name)
+#define EPROFILE_END_FRAME()
+
+#endif
@@ -14,6 +14,7 @@ struct ESWindowParams {
 		h = 720;
 		vsync = false;
 		fullscreen = false;
+		headless = false;
 	}
 
 	// Settings constructor
@@ -23,7 +24,8 @@ struct ESWindowParams {
 		x(x), y(y), 
 		w(w), h(h),
 		vsync(false),
-		fullscreen(false)
+		fullscreen(false),
+		headless(false)
 	{}
 
 	// Title of the window
@@ -36,6 +38,8 @@ struct ESWindowParams {
 	bool vsync;
 	// Fullscreen enable
 	bool fullscreen;
+	// Run without an SDL window or OpenGL
+	bool headless;
 };
 
 struct SDL_Window;
@@ -9,8 +9,48 @@
 #include "Listeners/EInput.h"
 #include "Graphics/EModel.h"
 #include "Graphics/ESMaterial.h"
+#include "Math/ESpatialHash.h"
+#include "Game/EObjectRegistry.h"
+#include "Game/EObjectStore.h"
+#include "Game/EObjectPool.h"
+#include "Game/ETimerWheel.h"
+#include "Threading/EJobSystem.h"
 
 class EObject;
+class EWorldObject;
+
+// The tick list an object is in
+enum EETickList : EUi8 {
+	TL_NONE = 0U,
+	TL_SERIAL,
+	TL_PARALLEL
+};
+
+// The collider list a world object is in
+enum EEColliderList : EUi8 {
+	CL_NONE = 0U,
+	CL_DYNAMIC,
+	CL_STATIC
+};
+
+// Engine changes made during the parallel tick, one buffer per job system worker
+// Merged into the engine in PostLoop
+struct ESObjectCommandBuffer {
+	// Objects created while ticking in parallel
+	TArray<TShared<EObject>> objectsToBeSpawned;
+
+	// Objects destroyed while ticking in parallel
+	TArray<TShared<EObject>> objectsPendingDestroy;
+
+	// Objects that changed their tick settings while ticking in parallel
+	TArray<TWeak<EObject>> tickListChanges;
+
+	// World objects that changed their collisions while ticking in parallel
+	TArray<TWeak<EObject>> colliderChanges;
+
+	// Points added while ticking in parallel
+	int points = 0;
+};
 
 class EGameEngine {
 public:
@@ -26,7 +66,12 @@ public:
 	// Get the games points
 	int& GetPoints() { return m_points; }
 
+	// Add to the games points
+	// Safe to call from a parallel tick, the points are added in PostLoop
+	void AddPoints(int points);
+
 	// Return the delta time between frames
+	// When using a fixed time step this is the time between ticks
 	double DeltaTime() const { return m_deltaTime; }
 
 	// Return the delta time between frames as a float
@@ -40,11 +85,73 @@ public:
 		TShared<T> newObject = TMakeShared<T>(std::forward<Args>(args)...);
 
 		// Add the object into the stack
-		m_objectsToBeSpawned.push_back(newObject);
+		AddObjectToSpawn(newObject);
+
+		return newObject;
+	}
+
+	// Create an EObject type from its pool
+	// Reuses a destroyed object of the same type if one is free, otherwise creates a new one
+	// T must have a Reset function that takes the same args as its constructor
+	// Weak references to a destroyed pooled object can point to its reuse, use handles to check if it is alive
+	template<typename T, std::enable_if_t<std::is_base_of_v<EObject, T>, bool>* = nullptr, typename ... Args>
+	TWeak<T> CreatePooledObject(Args&&... args) {
+		TShared<T> newObject = m_objectPool.Take<T>();
+
+		if (newObject) {
+			// Clear the engine state from the last use then reset the object with the new args
+			newObject->ResetForReuse();
+			newObject->Reset(std::forward<Args>(args)...);
+		}
+		else {
+			newObject = TMakeShared<T>(std::forward<Args>(args)...);
+			newObject->m_poolIndex = EObjectPool::GetPoolIndex<T>();
+			m_objectPool.CountAllocation();
+		}
+
+		// Add the object into the stack
+		AddObjectToSpawn(newObject);
 
 		return newObject;
 	}
 
+	// Call a function after delay seconds of game time
+	// Repeating timers call the function every delay seconds until cleared
+	// Timers fire on the main thread at the start of Tick, they can't be set during the parallel tick
+	ESTimerHandle SetTimer(float delay, const std::function<void()>& callback, bool repeat = false);
+
+	// Call a function after delay seconds of game time while the owner is alive
+	// The timer is dropped without firing if the owner is destroyed first
+	ESTimerHandle SetTimer(const EObject* owner, float delay, const std::function<void()>& callback, bool repeat = false);
+
+	// Stop a timer before it fires and empty the handle
+	void ClearTimer(ESTimerHandle& handle);
+
+	// Check if a timer is waiting to fire
+	bool IsTimerActive(ESTimerHandle handle) const { return m_timers.IsActive(handle); }
+
+	// Destroy an object after life time seconds, 0 or less keeps the object alive
+	// The life time of an object that has not spawned starts when it spawns
+	void SetLifeTime(EObject* object, float lifeTime);
+
+	// Get the game time in seconds that timers fire against
+	// Only moves forward while the game ticks
+	double GetGameTime() const { return m_timers.GetTime(); }
+
+	// Move an object to the tick list it needs after its tick settings change
+	// The move happens in PostLoop
+	void UpdateTickList(EObject* object);
+
+	// Move a world object to the collider list it needs after its collisions or static setting change
+	// The move happens in PostLoop so the collider lists never change while collisions are tested
+	void UpdateColliderList(EWorldObject* object);
+
+	// Get the pool of destroyed objects waiting to be reused
+	EObjectPool& GetObjectPool() { return m_objectPool; }
+
+	// Get an object from its handle, returns nullptr if the object has been destroyed
+	EObject* GetObjectByHandle(ESObjectHandle handle) const { return m_objectStore.Get(handle); }
+
 	// Mark an object for destroy
 	// All game objects destroy functions will automatically run this
 	void DestroyObject(const TShared<EObject>& object);
@@ -61,6 +168,24 @@ public:
 	// Reset the frame rate
 	void ResetFrameRate() { SetFrameRate(m_defaultFrameRate); }
 
+	// Set whether the game ticks at a fixed rate separate to the frame rate
+	// Tick rate is the number of ticks per second
+	void SetFixedTimeStep(bool enabled, double tickRate = 60.0);
+
+	// Get whether the game ticks at a fixed rate
+	bool IsFixedTimeStep() const { return m_useFixedTimeStep; }
+
+	// Run without a window, OpenGL or input, must be set before Run
+	// Frame budget is the number of ticks to run before closing, 0 runs until closed
+	void SetHeadless(bool headless, EUi64 frameBudget = 0) { m_headless = headless; m_frameBudget = frameBudget; }
+
+	// Check if the engine is running without a window or OpenGL
+	bool IsHeadless() const { return m_headless; }
+
+	// Get how far the current render is between the last two ticks, from 0 to 1
+	// Always 1 when not using a fixed time step
+	float GetRenderAlpha() const { return m_renderAlpha; }
+
 	// Import a model from a path
 	TWeak<EModel> ImportModel(const EString& path);
 
@@ -76,37 +201,38 @@ public:
 	// Get window
 	TWeak<EWindow> GetWindow() { return m_window; }
 
+	// Get the engine job system
+	TUnique<EJobSystem>& GetJobSystem() { return m_jobSystem; }
+
 	// Find an object of type T from the object stack
 	template<typename T, typename = std::enable_if_t<std::is_base_of_v<EObject, T>>>
 	TWeak<T> FindObjectOfType() {
-		// Find an object within the object stack
-		for (const auto& eObjectRef : m_objectStack) {
-			if (const auto& cast = std::dynamic_pointer_cast<T>(eObjectRef)) {
-				// Match
-				return cast;
-			}
-				
-		}
+		const auto& objectsOfType = GetObjectsOfType<T>();
 
-		// Else no match, return empty
-		return {};
+		// No match, return empty
+		if (objectsOfType.empty())
+			return {};
+
+		// Return the first object spawned of that type
+		return objectsOfType.front();
 	}
 
 	// Find all objects of type T from the object stack
+	// Prefer GetObjectsOfType in code that runs every frame as this copies the objects
 	template<typename T, typename = std::enable_if_t<std::is_base_of_v<EObject, T>>>
 	TArray<TWeak<T>> FindAllObjectsOfType() {
-		TArray<TWeak<T>> objectsOfType = {};
-		// Find an object within the object stack
-		for (const auto& eObjectRef : m_objectStack) {
-			if (const auto& cast = std::dynamic_pointer_cast<T>(eObjectRef)) {
-				// Match
-				objectsOfType.push_back(cast);
-			}
-
-		}
+		const auto& objectsOfType = GetObjectsOfType<T>();
 
 		// Return found objects of type
-		return objectsOfType;
+		return TArray<TWeak<T>>(objectsOfType.begin(), objectsOfType.end());
+	}
+
+	// Get all objects of type T that are in the object stack
+	// Includes objects of any type derived from T
+	// Objects are bucketed by type as they spawn so this does not search or allocate
+	template<typename T, typename = std::enable_if_t<std::is_base_of_v<EObject, T>>>
+	const TArray<TShared<T>>& GetObjectsOfType() {
+		return m_objectRegistry.GetObjects<T>(m_objectStore.GetObjects());
 	}
 
 private:
@@ -130,6 +256,9 @@ private:
 	// Run game logic for the frame
 	void Tick();
 
+	// Test collisions between world objects that share a broadphase cell
+	void TestCollisions();
+
 	// Process the input for each frame
 	void ProcessInput();
 
@@ -142,6 +271,36 @@ private:
 	// Runs at the end of each loop
 	void PostLoop();
 
+	// Store the transforms before each fixed tick for render interpolation
+	void StorePreviousTransforms();
+
+	// Add the engine changes made during the parallel tick
+	void MergeCommandBuffers();
+
+	// Give a new object a handle and add it to be spawned next loop
+	void AddObjectToSpawn(const TShared<EObject>& newObject);
+
+	// Move objects whose tick settings changed into the tick list they need
+	void ApplyTickListChanges();
+
+	// Move an object into the tick list it needs
+	void MoveToTickList(EObject* object);
+
+	// Remove an object from its tick list by swapping the last object into its place
+	void RemoveFromTickList(EObject* object);
+
+	// Get the objects in a tick list
+	TArray<EObject*>* GetTickList(EETickList tickList);
+
+	// Move world objects whose collisions changed into the collider list they need
+	void ApplyColliderChanges();
+
+	// Move a world object into the collider list it needs
+	void MoveToColliderList(const TShared<EWorldObject>& object);
+
+	// Tick as fast as possible with no rendering or input until the frame budget is used
+	void HeadlessLoop();
+
 private:
 	// Store the window for the game engine
 	TShared<EWindow> m_window;
@@ -149,13 +308,40 @@ private:
 	// Store the input for the game engine
 	TShared<EInput> m_input;
 
-	// Last time ticked
-	double m_lastTickTime;
+	// Performance counter value at the start of the last frame
+	EUi64 m_lastCounter;
 
 	double m_deltaTime;
 
+	// Whether the game ticks at a fixed rate
+	bool m_useFixedTimeStep;
+
+	// Time between fixed ticks in seconds
+	double m_fixedDeltaTime;
+
+	// Time passed that has not been ticked yet
+	double m_accumulator;
+
+	// Longest frame time used, longer frames are clamped to this
+	double m_maxFrameTime;
+
+	// Most fixed ticks that can run in one frame
+	EUi32 m_maxTicksPerFrame;
+
+	// How far the render is between the last two ticks
+	float m_renderAlpha;
+
+	// Running without a window, OpenGL or input
+	bool m_headless;
+
+	// Number of ticks to run in headless mode, 0 runs until closed
+	EUi64 m_frameBudget;
+
 	// Store all EObjects in the game
-	TArray<TShared<EObject>> m_objectStack;
+	EObjectStore m_objectStore;
+
+	// Store the EObjects in the stack bucketed by type
+	EObjectRegistry m_objectRegistry;
 
 	// Store all EObjects to be started next frame
 	TArray<TShared<EObject>> m_objectsToBeSpawned;
@@ -163,15 +349,63 @@ private:
 	// Store all EObjects that have been marked for destroy
 	TArray<TShared<EObject>> m_objectsPendingDestroy;
 
+	// Destroyed pooled objects waiting to be reused
+	EObjectPool m_objectPool;
+
+	// Delayed and repeating callbacks, including object life times
+	ETimerWheel m_timers;
+
+	// Worker threads for the parallel tick
+	TUnique<EJobSystem> m_jobSystem;
+
+	// Engine changes made by each worker during the parallel tick
+	TArray<ESObjectCommandBuffer> m_commandBuffers;
+
+	// Set during the parallel tick so engine changes go into the command buffers
+	bool m_deferObjectChanges;
+
+	// Objects that tick on the job system workers
+	TArray<EObject*> m_parallelTickObjects;
+
+	// Objects that tick on the main thread
+	TArray<EObject*> m_serialTickObjects;
+
+	// Objects whose tick settings changed this loop, weak as they can be destroyed before PostLoop
+	TArray<TWeak<EObject>> m_tickListChanges;
+
+	// World objects whose collisions changed this loop
+	TArray<TWeak<EObject>> m_colliderChanges;
+
+	// World objects with collisions that move
+	TArray<TShared<EWorldObject>> m_dynamicColliders;
+
+	// World objects with collisions that never move
+	TArray<TShared<EWorldObject>> m_staticColliders;
+
+	// Broadphase grid for static colliders, only rebuilt when static colliders spawn or are destroyed
+	ESpatialHash m_staticBroadphase;
+
+	// Set when the static broadphase needs rebuilding
+	bool m_staticBroadphaseDirty;
+
+	// Static collider owner ids found by each query, reused each tick
+	TArray<EUi32> m_staticQueryResults;
+
+	// Broadphase grid for moving world object collisions, rebuilt each frame
+	ESpatialHash m_broadphase;
+
+
 	// Frame rate
 	unsigned int m_frameRate;
 
 	unsigned int m_defaultFrameRate;
 
-	// Store time taken to load so it can be subtracted
-	// Otherwise massive delta on first frame
-	double m_timeToLoad;
-
 	// Store the games points
 	int m_points;
-};
\ No newline at end of file
+};
+
+template<typename T>
+T* TObjectHandle<T>::Get() const
+{
+	return static_cast<T*>(EGameEngine::GetGameEngine()->GetObjectByHandle(m_handle));
+}
\ No newline at end of file
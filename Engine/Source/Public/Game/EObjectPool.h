@@ -0,0 +1,80 @@
+#pragma once
+#include "EngineTypes.h"
+
+// System Libs
+#include <atomic>
+#include <mutex>
+
+class EObject;
+
+// Free lists of destroyed objects that can be reused instead of allocated
+// Objects keep their memory, models and collisions while they wait in the pool
+class EObjectPool {
+public:
+	// Pool index for objects that are not pooled
+	static constexpr EUi32 noPool = ~0U;
+
+	EObjectPool();
+
+	// Take a free object of type T, returns nullptr if there are none
+	template<typename T>
+	TShared<T> Take() {
+		return std::static_pointer_cast<T>(Take(GetPoolIndex<T>()));
+	}
+
+	// Get the pool index for type T
+	template<typename T>
+	static EUi32 GetPoolIndex() {
+		static const EUi32 poolIndex = s_poolCount++;
+		return poolIndex;
+	}
+
+	// Return an object to the free list of its pool
+	void Release(const TShared<EObject>& object, EUi32 poolIndex);
+
+	// Count an object that was allocated because its pool was empty
+	void CountAllocation() { ++m_allocationsThisSecond; ++m_totalAllocations; }
+
+	// Update the per second counters, logs when the allocation rate changes
+	void UpdateStats(float deltaTime);
+
+	// Get the number of pooled objects allocated in the last second
+	EUi32 GetAllocationsPerSecond() const { return m_allocationsPerSecond; }
+
+	// Get the number of pooled objects reused in the last second
+	EUi32 GetReusesPerSecond() const { return m_reusesPerSecond; }
+
+	// Get the number of pooled objects allocated since the game started
+	EUi64 GetTotalAllocations() const { return m_totalAllocations; }
+
+	// Get the number of objects waiting in all pools
+	EUi32 GetFreeCount();
+
+private:
+	// Take a free object from a pool
+	TShared<EObject> Take(EUi32 poolIndex);
+
+private:
+	// Number of types that have been given a pool index
+	inline static std::atomic<EUi32> s_poolCount = 0;
+
+	// Objects can be taken from any thread during the parallel tick
+	std::mutex m_mutex;
+
+	// Free objects indexed by pool index
+	TArray<TArray<TShared<EObject>>> m_freeLists;
+
+	// Counters for the current second
+	std::atomic<EUi32> m_allocationsThisSecond;
+	std::atomic<EUi32> m_reusesThisSecond;
+
+	// Counters for the last full second
+	EUi32 m_allocationsPerSecond;
+	EUi32 m_reusesPerSecond;
+
+	// Allocations since the game started
+	std::atomic<EUi64> m_totalAllocations;
+
+	// Time since the counters last rolled over
+	float m_statsTimer;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include "EngineTypes.h"
+
+// System Libs
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+class EObject;
+
+// Base for a bucket of objects that share a type
+class EObjectBucketBase {
+public:
+	virtual ~EObjectBucketBase() = default;
+
+	// Add the object if it is the buckets type or derives from it
+	virtual void TryAdd(const TShared<EObject>& object) = 0;
+
+	// Remove all objects found in the sorted removed array
+	virtual void Remove(const TArray<EObject*>& sortedRemoved) = 0;
+};
+
+// Bucket holding every object of type T, in the order they were added
+template<typename T>
+class EObjectBucket : public EObjectBucketBase {
+public:
+	virtual void TryAdd(const TShared<EObject>& object) override {
+		if (auto cast = std::dynamic_pointer_cast<T>(object)) {
+			m_objects.push_back(std::move(cast));
+		}
+	}
+
+	virtual void Remove(const TArray<EObject*>& sortedRemoved) override {
+		std::erase_if(m_objects, [&sortedRemoved](const TShared<T>& object) {
+			return std::binary_search(sortedRemoved.begin(), sortedRemoved.end(), static_cast<EObject*>(object.get()));
+		});
+	}
+
+	// Get all objects in the bucket
+	const TArray<TShared<T>>& GetObjects() const { return m_objects; }
+
+private:
+	TArray<TShared<T>> m_objects;
+};
+
+// Stores objects in buckets by type so typed lookups don't scan the object stack
+// Buckets are created the first time a type is asked for
+// After that, objects are only type checked once when they are added
+// Types can be asked for from the parallel tick, objects are only added and removed on the main thread
+class EObjectRegistry {
+public:
+	// Add an object to every bucket it belongs to
+	void Add(const TShared<EObject>& object);
+
+	// Remove objects from every bucket
+	void Remove(TArray<EObject*>& removed);
+
+	// Remove all objects and buckets
+	void Clear() {
+		std::lock_guard<std::mutex> lock(m_bucketMutex);
+		m_buckets.clear();
+	}
+
+	// Get every object of type T
+	// The object stack is only used to fill the bucket the first time T is asked for
+	template<typename T>
+	const TArray<TShared<T>>& GetObjects(const TArray<TShared<EObject>>& objectStack) {
+		const EUi32 typeIndex = GetTypeIndex<T>();
+
+		// Buckets don't move once created so the objects can be read after unlocking
+		std::lock_guard<std::mutex> lock(m_bucketMutex);
+
+		if (typeIndex >= m_buckets.size())
+			m_buckets.resize(typeIndex + 1);
+
+		// Create and fill the bucket on first use
+		if (!m_buckets[typeIndex]) {
+			auto newBucket = TMakeUnique<EObjectBucket<T>>();
+			for (const auto& object : objectStack) {
+				newBucket->TryAdd(object);
+			}
+			m_buckets[typeIndex] = std::move(newBucket);
+		}
+
+		return static_cast<EObjectBucket<T>*>(m_buckets[typeIndex].get())->GetObjects();
+	}
+
+private:
+	// Get a unique index for type T
+	template<typename T>
+	static EUi32 GetTypeIndex() {
+		static const EUi32 typeIndex = s_typeCount++;
+		return typeIndex;
+	}
+
+private:
+	// Number of types that have been given an index
+	inline static std::atomic<EUi32> s_typeCount = 0;
+
+	// Buckets indexed by type index, empty until the type is asked for
+	TArray<TUnique<EObjectBucketBase>> m_buckets;
+
+	// Held while the buckets are created, filled or emptied
+	std::mutex m_bucketMutex;
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include "EngineTypes.h"
+
+class EObject;
+
+// 32 bit generational handle to an object in the object store
+// The low bits are the slot index and the high bits are the slot generation
+// A handle goes stale when its object is removed, even if the slot is reused
+struct ESObjectHandle {
+	static const EUi32 indexBits = 20;
+	static const EUi32 indexMask = (1U << indexBits) - 1;
+
+	ESObjectHandle() { id = 0; }
+
+	ESObjectHandle(EUi32 index, EUi32 generation) {
+		id = (generation << indexBits) | (index & indexMask);
+	}
+
+	// Get the slot index of the handle
+	EUi32 GetIndex() const { return id & indexMask; }
+
+	// Get the slot generation of the handle
+	EUi32 GetGeneration() const { return id >> indexBits; }
+
+	// Generation 0 is never used so an id of 0 is an empty handle
+	bool IsSet() const { return id != 0; }
+
+	bool operator==(const ESObjectHandle& other) const { return id == other.id; }
+	bool operator!=(const ESObjectHandle& other) const { return id != other.id; }
+
+	EUi32 id;
+};
+
+// Typed handle to an object in the engine
+// Checks if the object is alive through the object store instead of a weak pointer refcount
+template<typename T>
+class TObjectHandle {
+public:
+	TObjectHandle() = default;
+	TObjectHandle(ESObjectHandle handle) : m_handle(handle) {}
+
+	// Get the object, returns nullptr if the object has been removed from the engine
+	// Defined in EGameEngine.h
+	T* Get() const;
+
+	// Check if the object is still in the engine
+	bool IsValid() const { return Get() != nullptr; }
+
+	// Get the untyped handle
+	ESObjectHandle GetHandle() const { return m_handle; }
+
+	T* operator->() const { return Get(); }
+	explicit operator bool() const { return IsValid(); }
+
+private:
+	ESObjectHandle m_handle;
+};
+
+// Slot map of every object in the engine
+// Objects are stored densely for iteration and addressed by generational handles
+// Removing an object swaps the last object into its place so it never shifts the array
+class EObjectStore {
+public:
+	// Reserve a handle for a newly created object
+	// The object can be found by its handle straight away but is not iterated until Add
+	ESObjectHandle Reserve(EObject* object);
+
+	// Add a reserved object to the dense object array
+	void Add(const TShared<EObject>& object, ESObjectHandle handle);
+
+	// Remove an added object and free its handle
+	// Returns false if the handle is stale or the object was never added
+	bool Remove(ESObjectHandle handle);
+
+	// Free the handle of a reserved object that was never added
+	// Returns false if the handle is stale or the object was added
+	bool Release(ESObjectHandle handle);
+
+	// Get an object from a handle, returns nullptr if the handle is stale
+	EObject* Get(ESObjectHandle handle) const {
+		const EUi32 index = handle.GetIndex();
+		if (index >= m_slots.size() || m_slots[index].generation != handle.GetGeneration())
+			return nullptr;
+
+		return m_slots[index].object;
+	}
+
+	// Check if a handle is for an object that has been added
+	bool IsAdded(ESObjectHandle handle) const {
+		return Get(handle) && m_slots[handle.GetIndex()].denseIndex != notAdded;
+	}
+
+	// Get all added objects
+	// The order changes when objects are removed
+	const TArray<TShared<EObject>>& GetObjects() const { return m_objects; }
+
+private:
+	// Index used for slots that have not been added to the dense array
+	static const EUi32 notAdded = 0xFFFFFFFF;
+
+	// Empty a slot and make the handles to it stale
+	void FreeSlot(EUi32 index);
+
+	struct ESObjectSlot {
+		// Object in the slot, nullptr when free
+		EObject* object = nullptr;
+
+		// Index of the object in the dense array
+		EUi32 denseIndex = notAdded;
+
+		// Increased every time the slot is freed
+		EUi32 generation = 1;
+	};
+
+	// Slots addressed by handle index
+	TArray<ESObjectSlot> m_slots;
+
+	// Free slot indices to reuse
+	TArray<EUi32> m_freeSlots;
+
+	// Dense array of added objects
+	TArray<TShared<EObject>> m_objects;
+
+	// Slot index of each object in the dense array
+	TArray<EUi32> m_denseToSlot;
+};
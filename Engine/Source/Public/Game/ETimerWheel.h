@@ -0,0 +1,123 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Game/EObjectStore.h"
+
+// System Libs
+#include <functional>
+
+// Handle to a timer in the timer wheel
+// A handle goes stale when its timer fires or is cleared, even if the timer is reused
+struct ESTimerHandle {
+	// Index of the timer in the wheel
+	EUi32 index = 0;
+
+	// Generation 0 is never used so an empty handle is never active
+	EUi32 generation = 0;
+
+	// Check if the handle has been set
+	bool IsSet() const { return generation != 0; }
+};
+
+// Hierarchical timing wheel for delayed and repeating callbacks
+// Each level is a ring of slots, a slot on a higher level covers a full turn of the level below
+// Timers are added to the slot they expire in and move down a level when that slot is reached
+// Adding, clearing and firing a timer never searches so the cost does not grow with the timer count
+class ETimerWheel {
+public:
+	// Resolution is the time of one wheel step in seconds
+	ETimerWheel(double resolution = 0.001);
+
+	// Add a timer that calls the callback after delay seconds
+	// Repeating timers call the callback every delay seconds until cleared
+	// Timers with an owner are dropped without firing when the owner is destroyed
+	ESTimerHandle Add(double delay, const std::function<void()>& callback, bool repeat = false, ESObjectHandle owner = {});
+
+	// Stop a timer before it fires, does nothing if the timer is stale
+	void Clear(ESTimerHandle handle);
+
+	// Check if a timer is waiting to fire
+	bool IsActive(ESTimerHandle handle) const {
+		return handle.IsSet() && handle.index < m_timers.size() && m_timers[handle.index].generation == handle.generation;
+	}
+
+	// Move the wheel forward by seconds, firing every timer that expires
+	// The object store is used to drop timers whose owner has been destroyed
+	void Advance(double seconds, const EObjectStore& objectStore);
+
+	// Get the time the wheel has advanced to in seconds
+	double GetTime() const { return (double)m_currentStep * m_resolution; }
+
+	// Get the number of timers waiting to fire
+	EUi32 GetActiveCount() const { return m_activeCount; }
+
+private:
+	// Number of slots in each level, must be a power of 2
+	static const EUi32 slotBits = 6;
+	static const EUi32 slotCount = 1U << slotBits;
+	static const EUi32 slotMask = slotCount - 1;
+
+	// Number of levels, 4 levels of 64 slots at 1ms covers over 4 hours
+	static const EUi32 levelCount = 4;
+
+	// Index used for the end of a slot list and timers that are not in a slot
+	static const EUi32 invalidIndex = 0xFFFFFFFF;
+
+	struct ESTimer {
+		// Function to call when the timer fires
+		std::function<void()> callback;
+
+		// Step the timer fires on
+		EUi64 expiryStep = 0;
+
+		// Steps between repeats, 0 if the timer does not repeat
+		EUi64 intervalSteps = 0;
+
+		// Object the timer is dropped with
+		ESObjectHandle owner;
+
+		// Increased every time the timer is freed
+		EUi32 generation = 1;
+
+		// Slot the timer is in and its neighbours in the slot list
+		EUi32 slot = invalidIndex;
+		EUi32 next = invalidIndex;
+		EUi32 prev = invalidIndex;
+	};
+
+	// Move the wheel forward one step, cascading and firing the timers in the new slot
+	void Step(const EObjectStore& objectStore);
+
+	// Add a timer to the slot it expires in
+	void Schedule(EUi32 index);
+
+	// Remove a timer from its slot list
+	void Unlink(EUi32 index);
+
+	// Free a timer so it can be reused, makes its handles stale
+	void Free(EUi32 index);
+
+	// Fire a timer that has reached its expiry step
+	void Fire(EUi32 index, const EObjectStore& objectStore);
+
+private:
+	// Time of one step in seconds
+	double m_resolution;
+
+	// Time passed that is less than one step
+	double m_accumulator;
+
+	// Steps the wheel has advanced since it was created
+	EUi64 m_currentStep;
+
+	// Every timer, addressed by handle index
+	TArray<ESTimer> m_timers;
+
+	// Free timer indices to reuse
+	TArray<EUi32> m_freeTimers;
+
+	// First timer in each slot, indexed by level * slotCount + slot
+	TArray<EUi32> m_slotHeads;
+
+	// Number of timers waiting to fire
+	EUi32 m_activeCount;
+};
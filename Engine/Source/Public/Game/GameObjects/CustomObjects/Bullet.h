@@ -5,6 +5,9 @@ class Bullet : public EWorldObject {
 public:
 	Bullet(EECollisionType collisionType, glm::vec3 moveVector, float damage, float moveSpeed, float lifetime, glm::vec3 spawnPos, glm::vec3 spawnRot);
 
+	// Reset a pooled bullet to be fired again
+	void Reset(EECollisionType collisionType, glm::vec3 moveVector, float damage, float moveSpeed, float lifetime, glm::vec3 spawnPos, glm::vec3 spawnRot);
+
 protected:
 	virtual void OnStart() override;
 
@@ -5,10 +5,10 @@ class Player;
 
 class Enemy : public Character {
 public:
-	Enemy(TWeak<Player> playerRef);
+	Enemy(TObjectHandle<Player> playerRef);
 
 	// Spawn another enemy
-	static void SpawnEnemy(TWeak<Player> playerRef);
+	static void SpawnEnemy(TObjectHandle<Player> playerRef);
 
 protected:
 	virtual void OnStart() override;
@@ -23,7 +23,8 @@ protected:
 	virtual void OnTakeDamage(float damage) override;
 
 private:
-	TWeak<Player> m_playerRef;
+	// Handle to the player, checked every frame so avoids locking a weak pointer
+	TObjectHandle<Player> m_playerRef;
 
 	// Store the weapon offset
 	glm::vec3 m_weaponOffset;
@@ -21,8 +21,6 @@ public:
 protected:
 	virtual void OnStart() override;
 
-	virtual void OnTick(float deltaTime) override;
-
 private:
 	// Fire the gun to spawn and bullet
 	void Fire(EECollisionType bulletCollisionType, glm::vec3 shootDirection);
@@ -46,8 +44,8 @@ private:
 	// Time between attacks
 	float m_attackCooldownTime;
 
-	// Time until next attack
-	float m_attackTimer;
+	// Game time the weapon can attack again
+	double m_nextAttackTime;
 
 	// Ammo in reserve
 	EUi32 m_reserveAmmo;
@@ -40,12 +40,20 @@ public:
 		return std::static_pointer_cast<T>(shared_from_this());
 	}
 
-	// Set the lifetime of the object to be destroyed after seconds
-	void SetLifeTime(float lifeTime) { 
-		m_lifeTime = lifeTime; 
-		m_lifeTimeTimer = m_lifeTime;
+	// Get the engine handle for the object
+	ESObjectHandle GetHandle() const { return m_handle; }
+
+	// Get a typed handle reference
+	// Cheaper than a weak reference to check if the object is still alive
+	template<typename T>
+	TObjectHandle<T> GetHandleRef() const {
+		return TObjectHandle<T>(m_handle);
 	}
 
+	// Set the lifetime of the object to be destroyed after seconds
+	// The object does not need to tick for its lifetime to run out
+	void SetLifeTime(float lifeTime) { EGameEngine::GetGameEngine()->SetLifeTime(this, lifeTime); }
+
 	// Render
 	const bool ToggleRender() { m_doRender = !m_doRender; return m_doRender; }
 
@@ -53,6 +61,22 @@ public:
 
 	const bool GetDoRender() { return m_doRender; }
 
+	// Set if the object ticks on the job system workers instead of the main thread
+	// Only use if Tick and PostTick change nothing but this object and objects it owns
+	// CreateObject, Destroy and AddPoints are delayed until PostLoop, other engine calls are not safe
+	void SetParallelTick(bool parallelTick);
+
+	// Set if the object needs Tick and PostTick every frame
+	// Objects that do nothing per frame should disable this in OnStart so the engine never visits them
+	// Can be changed after spawning to make an object dormant, takes effect after PostLoop
+	void SetTickEnabled(bool tickEnabled);
+
+	// Check if the object needs Tick and PostTick every frame
+	bool IsTickEnabled() const { return m_tickEnabled; }
+
+	// Check if the object ticks on the job system workers
+	bool CanTickInParallel() const { return m_parallelTick; }
+
 protected:
 	// Run when the object spawns in
 	virtual void OnStart() {}
@@ -70,18 +94,40 @@ protected:
 	virtual void OnDestroy() {}
 
 private:
+	// Engine sets the handle when the object is created
+	friend class EGameEngine;
+
+	// Handle for the object in the engine object store
+	ESObjectHandle m_handle;
+
+	// Pool the object returns to when destroyed, noPool if not pooled
+	EUi32 m_poolIndex;
+
+	// Clear the engine state so a pooled object can be spawned again
+	void ResetForReuse();
+
 	// If marked for destroy
 	bool m_pendingDestroy;
 	
 	// If set, destroy object after time
 	float m_lifeTime;
 
-	// Time before destroy
-	float m_lifeTimeTimer;
+	// Engine timer that destroys the object when the lifetime runs out
+	ESTimerHandle m_lifeTimeTimer;
 
 	// Whether object is rendered
 	bool m_doRender;
 
+	// Whether the object ticks on the job system workers
+	bool m_parallelTick;
+
+	// Whether the object needs Tick and PostTick
+	bool m_tickEnabled;
+
+	// The engine tick list the object is in and its index in that list
+	EETickList m_tickList;
+	EUi32 m_tickIndex;
+
 	// Store unbinds for input bindings
 	TArray<std::function<void()>> m_inputUnbinds;
 };
\ No newline at end of file
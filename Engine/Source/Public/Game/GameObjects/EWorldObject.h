@@ -33,7 +33,27 @@ public:
 	TWeak<ESCollision> AddCollision(const ESBox& box, const bool& debug = false);
 
 	// Get the objects transform
-	ESTransform& GetTransform() { return m_transform; }
+	// Change it through the setters so the cached matrices and collisions follow
+	const ESTransform& GetTransform() const { return m_transform; }
+
+	// Set the position in world space
+	void SetPosition(const glm::vec3& position);
+
+	// Set the rotation in world space
+	void SetRotation(const glm::vec3& rotation);
+
+	// Set the scale in world space
+	void SetScale(const glm::vec3& scale);
+
+	// Store the current transform as the transform before the next tick
+	void StorePreviousTransform() { m_previousTransform = m_transform; }
+
+	// Get the transform to render with, blended between the last two ticks
+	ESTransform GetRenderTransform() const;
+
+	// Get the model matrix to render with, blended from the last tick by the render alpha
+	// Uses the cached matrix of the transform when there is nothing to blend
+	glm::mat4 GetRenderMatrix() const;
 
 	// Run a test to see if another object is overlapping
 	void TestCollision(const TShared<EWorldObject>& other);
@@ -47,6 +67,20 @@ public:
 	// Does the object have collisions
 	bool HasCollisions() const { return m_objectCollisions.size() > 0; }
 
+	// Get the collisions attached to the object
+	const TArray<TShared<ESCollision>>& GetCollisions() const { return m_objectCollisions; }
+
+	// Move the collisions to follow the object
+	// Only moves them when the transform changed since they were placed
+	void UpdateCollisions();
+
+	// Set if the objects collisions never move
+	// Static colliders are only tested against moving colliders, changes after spawning take effect after PostLoop
+	void SetStaticCollider(bool staticCollider);
+
+	// Check if the objects collisions never move
+	bool IsStaticCollider() const { return m_staticCollider; }
+
 	// Place on a random vertex of a floor
 	void PlaceOnFloorRandomly(TShared<Floor> floor, float placementScale);
 
@@ -60,12 +94,27 @@ protected:
 		const TShared<ESCollision>& otherCol) {}
 
 private:
+	// Engine sorts the object into the collider lists
+	friend class EGameEngine;
+
 	// Transform in world space
 	ESTransform m_transform;
 
+	// Transform before the last fixed tick
+	ESTransform m_previousTransform;
+
 	// Store any models attached to this object
 	TArray<TWeak<EModel>> m_objectModels;
 
 	// Store the collisions for the model
 	TArray<TShared<ESCollision>> m_objectCollisions;
+
+	// Whether the collisions need to move to the transform
+	bool m_collisionsDirty = false;
+
+	// Whether the collisions never move
+	bool m_staticCollider = false;
+
+	// The engine collider list the object is in
+	EEColliderList m_colliderList = CL_NONE;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include "EngineTypes.h"
+
+// System Libs
+#include <atomic>
+
+// Load progress of an asset
+enum EEAssetState : EUi8 {
+	AS_QUEUED = 0U,	// Waiting for a thread to load it
+	AS_LOADING,		// File is being read and decoded
+	AS_LOADED,		// Decoded, waiting to be uploaded to OpenGL
+	AS_READY,		// Uploaded and usable
+	AS_FAILED		// Failed to load or upload, the error has been logged
+};
+
+// Asset loaded in two steps so the slow file work can run on any thread
+// LoadData reads and decodes the file without OpenGL, UploadData then runs on the render thread
+// The state doubles as a future, other threads check it to see when the data has landed
+class EAsset {
+public:
+	virtual ~EAsset() = default;
+
+	// Get how far the asset has loaded
+	EEAssetState GetLoadState() const { return m_loadState.load(std::memory_order_acquire); }
+
+	// Check if the asset has uploaded and is usable
+	bool IsReady() const { return GetLoadState() == AS_READY; }
+
+protected:
+	friend class EAssetManager;
+
+	// Read and decode the file, runs on a worker thread so must not use OpenGL
+	virtual bool LoadData() = 0;
+
+	// Upload the decoded data to OpenGL, runs on the render thread
+	virtual bool UploadData() = 0;
+
+	// Get the number of bytes UploadData will send to OpenGL
+	virtual size_t GetUploadSize() const = 0;
+
+	// Run LoadData if no other thread has started it
+	// Returns false if the asset was already loading or loaded
+	bool RunLoad() {
+		EEAssetState expected = AS_QUEUED;
+		if (!m_loadState.compare_exchange_strong(expected, AS_LOADING, std::memory_order_acq_rel))
+			return false;
+
+		m_loadState.store(LoadData() ? AS_LOADED : AS_FAILED, std::memory_order_release);
+		return true;
+	}
+
+	// Run UploadData once the data has loaded
+	bool RunUpload() {
+		if (GetLoadState() != AS_LOADED)
+			return false;
+
+		const bool uploaded = UploadData();
+		m_loadState.store(uploaded ? AS_READY : AS_FAILED, std::memory_order_release);
+		return uploaded;
+	}
+
+private:
+	// Written by the loading thread and read by the render thread
+	std::atomic<EEAssetState> m_loadState = AS_QUEUED;
+};
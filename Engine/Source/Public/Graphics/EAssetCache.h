@@ -0,0 +1,85 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Graphics/ESMaterial.h"
+#include "Graphics/ETexture.h"
+
+// System Libs
+#include <unordered_map>
+
+class EAssetManager;
+
+// Lookups and memory use of the asset cache
+struct ESAssetCacheStats {
+	// Lookups that found an entry and lookups that created one
+	EUi64 hits = 0;
+	EUi64 misses = 0;
+
+	// Entries removed because nothing used them
+	EUi64 evictions = 0;
+
+	// Number of entries held
+	EUi32 textures = 0;
+	EUi32 materials = 0;
+
+	// GPU memory of the uploaded textures in bytes
+	size_t residentBytes = 0;
+};
+
+// Shared textures and materials keyed by everything that makes them different
+// Textures are keyed by path and sampler settings, materials by the full material description
+// An entry is unused when the cache holds the only reference, unused entries are evicted after a delay
+class EAssetCache {
+public:
+	// Frames an entry stays unused before it is evicted
+	// Stops assets that are briefly unused, like a respawning object's, from loading again
+	static const EUi32 evictionDelay = 600;
+
+	EAssetCache(EAssetManager& assetManager);
+
+	// Get the texture for a path and sampler settings, loading it in the background if it is not cached
+	TShared<ETexture> GetTexture(const EString& path, bool repeat = true, bool linear = true, EETextureType type = TT_COLOUR);
+
+	// Get the material for a description, creating it and loading its maps if it is not cached
+	TShared<ESMaterial> GetMaterial(const ESMaterialDesc& desc);
+
+	// Evict the entries that have been unused for longer than the eviction delay, called once per frame
+	void Update();
+
+	// Get the lookups since the cache was created and what it holds now
+	ESAssetCacheStats GetStats() const;
+
+private:
+	template<typename T>
+	struct TCacheEntry {
+		TShared<T> asset;
+
+		// Last frame something other than the cache referenced the asset
+		EUi64 lastUsedFrame = 0;
+	};
+
+	// Remove the entries that have been unused for at least the eviction delay
+	template<typename T>
+	void Evict(std::unordered_map<EString, TCacheEntry<T>>& entries);
+
+	// Build the key of a texture from its path, sampler settings and type
+	static EString MakeTextureKey(const EString& path, bool repeat, bool linear, EETextureType type);
+
+	// Build the key of a material from every value in its description
+	static EString MakeMaterialKey(const ESMaterialDesc& desc);
+
+private:
+	// Starts the background loads of new textures
+	EAssetManager& m_assetManager;
+
+	// Cached entries by key
+	std::unordered_map<EString, TCacheEntry<ETexture>> m_textures;
+	std::unordered_map<EString, TCacheEntry<ESMaterial>> m_materials;
+
+	// Frames updated since the cache was created
+	EUi64 m_frame;
+
+	// Lookup and eviction counts
+	EUi64 m_hits;
+	EUi64 m_misses;
+	EUi64 m_evictions;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Graphics/EAsset.h"
+
+// System Libs
+#include <mutex>
+
+// Loads assets in the background and uploads them to OpenGL a few at a time
+// Files are read and decoded on the job system workers so every core works on loading
+// Uploads run in Update on the render thread, capped each frame so a frame never stalls
+class EAssetManager {
+public:
+	// Most bytes uploaded to OpenGL in one frame, at least one asset is always uploaded
+	static const size_t uploadBudget = 8 * 1024 * 1024;
+
+	EAssetManager(bool synchronous);
+
+	// Start loading an asset, it is uploaded by a later Update
+	// Synchronous managers load and upload the asset straight away
+	void Load(const TShared<EAsset>& asset);
+
+	// Upload loaded assets until the frame budget is spent
+	void Update();
+
+	// Wait for an asset to load and upload it now
+	// Loads the asset on this thread if no worker has started it yet
+	void Finish(const TShared<EAsset>& asset);
+
+	// Get the number of assets still loading or waiting to upload
+	EUi32 GetPendingCount() const { return (EUi32)m_pending.size(); }
+
+private:
+	// Assets waiting to be uploaded, in the order they were requested
+	// The only strong reference the manager holds, load tasks only hold weak references
+	TArray<TShared<EAsset>> m_pending;
+
+	// References the load tasks hand back so assets are only ever destroyed on the render thread
+	// Assets own OpenGL objects that can't be deleted on a worker with no GL context
+	TArray<TShared<EAsset>> m_released;
+	std::mutex m_releasedMutex;
+
+	// Load and upload on the calling thread, used when there is no render loop
+	bool m_synchronous;
+};
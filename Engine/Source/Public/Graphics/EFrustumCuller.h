@@ -0,0 +1,51 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Math/ESFrustum.h"
+
+// Objects tested against the frustum and objects that passed in the last cull
+struct ESCullStats {
+	EUi32 objectsConsidered = 0;
+	EUi32 objectsDrawn = 0;
+};
+
+// Tests bounding spheres against a frustum four at a time
+// Spheres are packed into separate x, y, z and radius arrays so each plane test is one SIMD operation
+class EFrustumCuller {
+public:
+	EFrustumCuller() = default;
+
+	// Remove every sphere
+	void Clear();
+
+	// Add a sphere to test, returns its index
+	EUi32 Add(const glm::vec3& center, float radius);
+
+	// Test every sphere against the frustum
+	// Returns the number of spheres that are at least partly inside
+	EUi32 Cull(const ESFrustum& frustum);
+
+	// Check if a sphere passed the last cull
+	bool IsVisible(EUi32 index) const { return m_visible[index] != 0; }
+
+	// Get the number of spheres added
+	EUi32 GetCount() const { return m_count; }
+
+	// Get the stats of the last cull
+	const ESCullStats& GetStats() const { return m_stats; }
+
+private:
+	// Packed sphere data, padded to a multiple of 4
+	TArray<float> m_centerX;
+	TArray<float> m_centerY;
+	TArray<float> m_centerZ;
+	TArray<float> m_radius;
+
+	// 1 if the sphere passed the last cull
+	TArray<EUi8> m_visible;
+
+	// Number of spheres added
+	EUi32 m_count = 0;
+
+	// Stats of the last cull
+	ESCullStats m_stats;
+};
@@ -1,13 +1,20 @@
 #pragma once
 #include "EngineTypes.h"
 #include "Graphics/ESMaterial.h"
+#include "Graphics/ELightBuffer.h"
+#include "Graphics/ERenderQueue.h"
+#include "Graphics/EFrustumCuller.h"
+#include "Graphics/EAssetManager.h"
+#include "Graphics/EAssetCache.h"
 
 typedef void* SDL_GLContext;
 struct SDL_Window;
 class EShaderProgram;
 struct ESCamera;
 class EModel;
+class ETexture;
 struct ESCollision;
+class EScreenObject;
 
 struct ESLight;
 struct ESPointLight;
@@ -45,6 +52,13 @@ public:
 	// Initialise the graphics engine
 	bool InitEngine(SDL_Window* sdlWindow, const bool& vsync);
 
+	// Initialise the graphics engine without a window or OpenGL
+	// Models, lights and the camera still exist but nothing is rendered
+	bool InitHeadless();
+
+	// Check if the graphics engine is running without OpenGL
+	bool IsHeadless() const { return m_headless; }
+
 	// Render the graphics engine
 	void Render(SDL_Window* sdlWindow);
 
@@ -60,9 +74,23 @@ public:
 	// Create a spot light and return a weak pointer
 	TWeak<ESSpotLight> CreateSpotLight();
 
-	// Import a model and return a weak pointer
+	// Remove a light from the engine
+	void RemoveLight(const TShared<ESLight>& light);
+
+	// Start importing a model in the background
+	// The model has no meshes until it has loaded
 	TShared<EModel> ImportModel(const EString& path);
 
+	// Get a cached texture, loading it in the background if it is not cached
+	// The texture binds the default texture until it has loaded
+	TShared<ETexture> LoadTexture(const EString& path, bool repeat = true, bool linear = true);
+
+	// Get the asset manager that loads the models and textures
+	EAssetManager& GetAssetManager() { return *m_assetManager; }
+
+	// Get the cache that shares textures and materials
+	EAssetCache& GetAssetCache() { return *m_assetCache; }
+
 	// Create a material for the engine
 	TShared<ESMaterial> CreateMaterial();
 
@@ -88,12 +116,31 @@ public:
 	TArray<TShared<EModel>>& GetModels() { return m_models; }
 
 	// Get the lights stack
-	TArray<TShared<ESLight>>& GetLights() { return m_lights; }
+	const TArray<TShared<ESLight>>& GetLights() const { return m_lights; }
+
+	// Get the draw calls and state changes of the last rendered world
+	const ESRenderStats& GetRenderStats() const { return m_renderQueue.GetStats(); }
+
+	// Get the models considered and drawn after culling the last rendered world
+	const ESCullStats& GetCullStats() const { return m_frustumCuller.GetStats(); }
+
+private:
+	// Render the world objects with the normal shader
+	void RenderWorld(float renderAlpha);
+
+	// Render the screen objects with the sprite shader
+	void RenderSprites();
+
+	// Render the debug collisions with the wire shader
+	void RenderWires(float renderAlpha);
 
 private:
 	// Storing memory location for OpenGL context
 	SDL_GLContext m_sdlGLContext;
 
+	// Running without OpenGL
+	bool m_headless;
+
 	// Store the shaders for the engine
 	TShared<EShaderProgram> m_shader;
 	TShared<EShaderProgram> m_wireShader;
@@ -105,9 +152,33 @@ private:
 	// Stores all the lights in the engine
 	TArray<TShared<ESLight>> m_lights;
 
+	// Shader storage buffers the lights are uploaded to each frame
+	TUnique<ELightBuffer> m_lightBuffer;
+
+	// Sorts the world draws each frame
+	ERenderQueue m_renderQueue;
+
+	// Culls the world models outside the camera view each frame
+	EFrustumCuller m_frustumCuller;
+
+	// Model and model matrix for each sphere in the culler
+	struct ESCullCandidate {
+		EModel* model;
+		glm::mat4 matModel;
+	};
+
+	// Models waiting for the cull, reused each frame
+	TArray<ESCullCandidate> m_cullCandidates;
+
 	// Stores all the models in the engine
 	TArray<TShared<EModel>> m_models;
 
+	// Loads models and textures in the background
+	TUnique<EAssetManager> m_assetManager;
+
+	// Shares textures and materials and evicts the unused ones
+	TUnique<EAssetCache> m_assetCache;
+
 	// Stores all of the collision meshes
 	TArray<TWeak<ESCollision>> m_collisions;
 
@@ -116,4 +187,7 @@ private:
 
 	// Store a default material
 	TShared<ESMaterial> m_defaultMaterial;
+
+	// Screen objects sorted by render order, reused each frame
+	TArray<TShared<EScreenObject>> m_sortedScreenObjects;
 };
@@ -0,0 +1,94 @@
+#pragma once
+#include "EngineTypes.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+struct ESLight;
+
+// Light data packed to match the std430 light structs in the simple shader
+// Each vec3 is followed by a float so the layout has no hidden padding
+struct ESDirLightData {
+	glm::vec3 colour;
+	float intensity;
+	glm::vec3 ambient;
+	float pad0;
+	glm::vec3 direction;
+	float pad1;
+};
+
+struct ESPointLightData {
+	glm::vec3 colour;
+	float intensity;
+	glm::vec3 position;
+	float linear;
+	float quadratic;
+	float pad0;
+	float pad1;
+	float pad2;
+};
+
+struct ESSpotLightData {
+	glm::vec3 colour;
+	float intensity;
+	glm::vec3 position;
+	float linear;
+	glm::vec3 direction;
+	float quadratic;
+	float innerCutOff;
+	float outerCutOff;
+	float pad0;
+	float pad1;
+};
+
+static_assert(sizeof(ESDirLightData) == 48, "Dir light data must match the std430 shader struct");
+static_assert(sizeof(ESPointLightData) == 48, "Point light data must match the std430 shader struct");
+static_assert(sizeof(ESSpotLightData) == 64, "Spot light data must match the std430 shader struct");
+
+// Shader storage buffers holding every light in the scene
+// Uploaded once per frame so draws never set light uniforms
+class ELightBuffer {
+public:
+	// Most lights of each type, lights over this are ignored
+	static const EUi32 maxLightsPerType = 1024;
+
+	// Storage buffer binding points used by the shaders
+	static const EUi32 dirLightBinding = 0;
+	static const EUi32 pointLightBinding = 1;
+	static const EUi32 spotLightBinding = 2;
+
+	ELightBuffer();
+	~ELightBuffer();
+
+	// Pack the lights that are on and upload them to the GPU
+	// Binds the buffers to their binding points
+	void Upload(const TArray<TShared<ESLight>>& lights);
+
+	// Get the number of lights of each type in the last upload
+	EUi32 GetDirLightCount() const { return (EUi32)m_dirLights.size(); }
+	EUi32 GetPointLightCount() const { return (EUi32)m_pointLights.size(); }
+	EUi32 GetSpotLightCount() const { return (EUi32)m_spotLights.size(); }
+
+private:
+	// Upload data to a buffer, growing it if it is too small
+	void UploadBuffer(EUi32 buffer, EUi32 binding, size_t& capacity, const void* data, size_t size);
+
+private:
+	// Packed lights, reused each frame
+	TArray<ESDirLightData> m_dirLights;
+	TArray<ESPointLightData> m_pointLights;
+	TArray<ESSpotLightData> m_spotLights;
+
+	// OpenGL buffer IDs
+	EUi32 m_dirLightBuffer;
+	EUi32 m_pointLightBuffer;
+	EUi32 m_spotLightBuffer;
+
+	// Size of each buffer in bytes
+	size_t m_dirLightCapacity;
+	size_t m_pointLightCapacity;
+	size_t m_spotLightCapacity;
+
+	// Only warn once when there are too many lights
+	bool m_loggedLightLimit;
+};
@@ -1,14 +1,36 @@
 #pragma once
 #include "EngineTypes.h"
+#include "Math/ESBounds.h"
 
 // External Libs
 #include <GLM/matrix.hpp>
 
 class EShaderProgram;
 struct ESTransform;
-struct ESLight;
 struct ESMaterial;
 
+// Attribute location of the first column of the instance world matrix
+// The matrix takes this location and the next three
+const EUi32 instanceMatrixLocation = 6;
+
+// Attribute location of the first column of the instance normal matrix
+// The matrix takes this location and the next two
+const EUi32 instanceNormalLocation = 10;
+
+// Vertex buffer binding the instance matrices are read from
+// Vertex attributes use the binding that matches their location so this can't be below 6
+const EUi32 instanceBufferBinding = 6;
+
+// Per instance data streamed by the render queue
+// Built once per instance on the CPU so the vertex shader never inverts a matrix
+struct ESInstanceData {
+	// Model and mesh matrix combined
+	glm::mat4 world;
+
+	// Inverse transpose of the world matrix, columns padded to vec4
+	glm::vec4 normalMatrix[3];
+};
+
 struct ESVertexData {
 	// 0 = x
 	// 1 = y
@@ -35,25 +57,101 @@ struct ESVertexData {
 	float m_bitTangent[3] = { 0.0f, 0.0f, 0.0f };
 };
 
+// Attributes a vertex layout can store, the position is always stored
+enum EEVertexAttribute : EUi8 {
+	VA_COLOUR = 1U << 0,
+	VA_TEX_COORDS = 1U << 1,
+	VA_NORMAL = 1U << 2,
+	VA_TANGENT = 1U << 3
+};
+
+// Formats texture coordinates can be stored in
+enum EETexCoordFormat : EUi8 {
+	TF_HALF = 0U,	// Any range, used when coordinates tile past 0 - 1
+	TF_UNORM16		// 0 - 1 only, more precise than half
+};
+
+// Describes which attributes a mesh stores on the GPU and how they are packed
+// Position		float3						12 bytes
+// Colour		unorm8 x4					4 bytes
+// Tex coords	half or unorm16 x2			4 bytes
+// Normal		octahedral snorm16 x2		4 bytes
+// Tangent		octahedral snorm16 x2, bitangent sign, padding	8 bytes
+struct ESVertexLayout {
+	// Create a layout for the attributes, picks the smallest tex coord format that fits the vertices
+	static ESVertexLayout Create(EUi8 attributes, const std::vector<ESVertexData>& vertices);
+
+	// Check if the layout stores an attribute
+	bool Has(EEVertexAttribute attribute) const { return (attributes & attribute) != 0; }
+
+	// Get the size of one vertex in bytes
+	EUi32 GetStride() const;
+
+	// Get the byte offset of an attribute in a vertex, position is always at 0
+	EUi32 GetOffset(EEVertexAttribute attribute) const;
+
+	// Pack vertices into the bytes of the layout
+	TArray<EUi8> Pack(const std::vector<ESVertexData>& vertices) const;
+
+	// Attributes stored, EEVertexAttribute flags
+	EUi8 attributes = 0;
+
+	// Format of the tex coords if stored
+	EETexCoordFormat texCoordFormat = TF_HALF;
+};
+
 class EMesh {
 public:
 	EMesh();
 	~EMesh();
 
 	// Create a mesh using vertex and index data
+	// The vertices are packed into the layout on the GPU, attributes not in the layout are dropped
 	bool CreateMesh(const std::vector<ESVertexData>& vertices,
-		const std::vector<uint32_t>& indices);
+		const std::vector<uint32_t>& indices, const ESVertexLayout& layout);
+
+	// Create a mesh from vertices already packed into the layout, like the data in a cooked mesh file
+	// Indices must be 16 bit when there are fewer than 65536 vertices, only the positions are kept on the CPU
+	bool CreatePackedMesh(const void* packedVertices, EUi32 vertexCount, const void* indices, EUi32 indexCount,
+		const ESVertexLayout& layout, const ESBounds& bounds);
+
+	// Draw instances of the mesh with the state already set by the render queue
+	// The VAO of the mesh must be bound and the instance buffer attached
+	void Draw(EUi32 instanceCount, EUi32 firstInstance) const;
 
-	// Draw the mesh to the renderer
-	void Render(const TShared<EShaderProgram>& shader, const ESTransform& transform,
-		const TArray<TShared<ESLight>>& lights, const TShared<ESMaterial>& material);
+	// Read the per instance model matrices from a buffer, the VAO of the mesh must be bound
+	// Does nothing if the buffer is already attached
+	void AttachInstanceBuffer(EUi32 buffer);
 
 	// Draw a wireframe of the mesh
-	void WireRender(const TShared<EShaderProgram>& shader, const ESTransform& transform);
+	void WireRender(const TShared<EShaderProgram>& shader, const glm::mat4& matModel);
 
 	// Set the transform of the mesh relative to the model
 	void SetRelativeTransform(const glm::mat4 &transform) { m_matTransform = transform; }
 
+	// Get the transform of the mesh relative to the model
+	const glm::mat4& GetRelativeTransform() const { return m_matTransform; }
+
+	// Get the bounds of the mesh before the relative transform
+	const ESBounds& GetBounds() const { return m_bounds; }
+
+	// Get the layout the vertices are stored in on the GPU
+	const ESVertexLayout& GetLayout() const { return m_layout; }
+
+	// Get the size of the vertex buffer on the GPU in bytes
+	size_t GetVertexBufferSize() const { return m_vertices.size() * m_layout.GetStride(); }
+
+	// Check if the indices are stored as 16 bit on the GPU, true when there are fewer than 65536 vertices
+	bool UsesShortIndices() const { return m_vertices.size() < 65536; }
+
+	// Get the size of the index buffer on the GPU in bytes
+	size_t GetIndexBufferSize() const {
+		return m_indices.size() * (UsesShortIndices() ? sizeof(EUi16) : sizeof(uint32_t));
+	}
+
+	// Get the ID of the vertex array object
+	uint32_t GetVAO() const { return m_vao; }
+
 	// Get the number of vertices stored in the mesh
 	size_t GetNumberOfVertices() { return m_vertices.size(); }
 
@@ -63,6 +161,10 @@ public:
 	// Get a random vertex position in the mesh
 	const glm::vec3 GetRandomVertexPosition();
 
+private:
+	// Create the VAO and upload the vertex and index buffers
+	bool UploadBuffers(const void* vertexData, size_t vertexSize, const void* indexData, size_t indexSize);
+
 public:
 	// Index for the material relative to the model
 	unsigned int materialIndex;
@@ -83,6 +185,18 @@ protected:
 	// Store the ID for the element array object
 	uint32_t m_eao;
 
+	// Store the ID for the buffer the instance matrices are read from
+	uint32_t m_instanceBuffer;
+
+	// OpenGL type of the indices on the GPU, 16 bit when the vertices fit
+	uint32_t m_indexType;
+
 	// Relative transform of the mesh
 	glm::mat4 m_matTransform;
+
+	// Bounds of the vertex positions
+	ESBounds m_bounds;
+
+	// Layout of the vertices on the GPU
+	ESVertexLayout m_layout;
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include "EngineTypes.h"
+
+struct ESVertexData;
+
+// Average cache miss ratio of a mesh before and after optimising
+struct ESMeshOptimizeStats {
+	EUi32 triangles = 0;
+	float acmrBefore = 0.0f;
+	float acmrAfter = 0.0f;
+};
+
+// Reorders mesh triangles and vertices at import so the GPU does less work per draw
+// Triangles are ordered for the post transform vertex cache with Tipsify,
+// then the clusters Tipsify makes are ordered so outward facing ones draw first to cut overdraw,
+// then vertices are ordered by first use so vertex fetches walk memory forwards
+class EMeshOptimizer {
+public:
+	// Size of the FIFO vertex cache the optimiser and ACMR assume
+	static const EUi32 cacheSize = 16;
+
+	// Run every optimisation on a triangle list
+	// Vertices that no triangle uses are removed
+	static ESMeshOptimizeStats Optimize(TArray<ESVertexData>& vertices, TArray<EUi32>& indices);
+
+	// Get the average number of vertex cache misses per triangle, 0.5 is ideal and 3 is the worst
+	static float ComputeACMR(const TArray<EUi32>& indices, EUi32 vertexCount);
+
+	// Reorder triangles for the vertex cache with Tipsify
+	// Fills clusters with the first triangle of each cluster, a new cluster starts each time the cache goes cold
+	static void OptimizeVertexCache(TArray<EUi32>& indices, EUi32 vertexCount, TArray<EUi32>& clusters);
+
+	// Reorder clusters so the ones facing out from the mesh center draw first
+	static void OptimizeOverdraw(TArray<EUi32>& indices, const TArray<ESVertexData>& vertices, const TArray<EUi32>& clusters);
+
+	// Reorder vertices by first use and remap the indices
+	static void OptimizeVertexFetch(TArray<ESVertexData>& vertices, TArray<EUi32>& indices);
+};
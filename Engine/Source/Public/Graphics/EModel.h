@@ -1,7 +1,10 @@
 #pragma once
 #include "EngineTypes.h"
 #include "Graphics/EMesh.h"
+#include "Graphics/EMeshOptimizer.h"
 #include "Math/ESTransform.h"
+#include "Graphics/EAsset.h"
+#include "IO/EMappedFile.h"
 
 // External Libs
 #include <ASSIMP/matrix4x4.h>
@@ -10,23 +13,39 @@ class ETexture;
 class EShaderProgram;
 struct aiScene;
 struct aiNode;
-struct ESLight;
 struct ESMaterial;
+class ERenderQueue;
 
-class EModel {
+class EModel : public EAsset {
 public:
+	// ASSIMP post processing flags used when importing models
+	static const EUi32 importFlags;
+
 	EModel(unsigned int spawnID, EString path);
 	~EModel();
 
-	// Import a 3D model from file
+	// Import a 3D model from file and upload it straight away
 	// Uses the ASSIMP import library, check docs to know which file types are accepted
+	// The imported meshes are cooked next to the file and loaded from there until the file changes
+	// Use the asset manager to import the model in the background instead
 	void ImportModel(const EString& filePath, const TShared<ESMaterial>& defaultMaterial);
+
+	// Set the material used for slots with no material when the model loads
+	void SetDefaultMaterial(const TShared<ESMaterial>& material) { m_defaultMaterial = material; }
 	
-	// Render all of the meshes within the model
-	// Transform of meshes will be based on models transform
-	void Render(const ESTransform& transform, const TShared<EShaderProgram>& shader, const TArray<TShared<ESLight>>& lights);
+	// Get the model matrix from the matrix of the object the model belongs to
+	// The model offset is applied in the space of the object
+	glm::mat4 GetModelMatrix(const glm::mat4& matObject) const;
+
+	// Add a draw for each mesh within the model to the render queue
+	// Transform of meshes will be based on the model matrix
+	void AddToRenderQueue(ERenderQueue& queue, const glm::mat4& matModel, EShaderProgram* shader);
+
+	// Get the bounds of every mesh in model space
+	const ESBounds& GetBounds() const { return m_bounds; }
 
 	// Set a material by the slot number
+	// Materials set before the model has loaded are applied once it loads
 	void SetMaterialBySlot(unsigned int slot, const TShared<ESMaterial>& material);
 
 	// Get the spawn ID of the model
@@ -44,11 +63,72 @@ public:
 	// Get model materials
 	const TArray<TShared<ESMaterial>>& GetMaterials() const { return m_materialStack; }
 
+	// Get the vertex cache miss ratio of every mesh before and after import optimisation
+	const ESMeshOptimizeStats& GetOptimizeStats() const { return m_optimizeStats; }
+
 public:
-	// Transform offset
+	// Transform offset from the object the model belongs to
 	ESTransform m_offset;
 
+protected:
+	// Read the cooked model or import the source model, runs on any thread
+	bool LoadData() override;
+
+	// Create the meshes from the loaded data and set up the material slots
+	bool UploadData() override;
+
+	// Get the size of the loaded vertex and index data in bytes
+	size_t GetUploadSize() const override;
+
 private:
+	// A mesh read from file, waiting to be uploaded
+	struct ESMeshImportData {
+		// Indices are 16 bit with fewer than 65536 vertices
+		bool UsesShortIndices() const { return vertexCount < 65536; }
+
+		// Get the size of the packed vertices in bytes
+		size_t GetVertexSize() const { return (size_t)vertexCount * layout.GetStride(); }
+
+		// Get the size of the indices in bytes
+		size_t GetIndexSize() const { return (size_t)indexCount * (UsesShortIndices() ? sizeof(EUi16) : sizeof(EUi32)); }
+
+		ESVertexLayout layout;
+		ESBounds bounds;
+		glm::mat4 relativeTransform = glm::mat4(1.0f);
+		EUi32 materialIndex = 0;
+		EUi32 vertexCount = 0;
+		EUi32 indexCount = 0;
+
+		// Packed vertices and indices, point into the cooked file or the owned arrays
+		const void* vertexData = nullptr;
+		const void* indexData = nullptr;
+
+		// Data packed after an ASSIMP import
+		TArray<EUi8> ownedVertices;
+		TArray<EUi8> ownedIndices;
+	};
+
+	// Everything read from file, held until the upload
+	struct ESModelImportData {
+		// Cooked file the mesh data points into, stays mapped until the upload
+		EMappedFile cookedFile;
+
+		TArray<ESMeshImportData> meshes;
+
+		// Number of material slots
+		EUi32 materialCount = 0;
+	};
+
+	// Import the meshes from the source model file with ASSIMP
+	bool ImportSourceModel(const EString& filePath);
+
+	// Load the meshes from a cooked model file
+	// Fails if there is no cooked file or it was cooked from a different version of the source
+	bool LoadCookedModel(const EString& cookedPath, const EString& sourcePath);
+
+	// Write the imported meshes to a cooked model file
+	void SaveCookedModel(const EString& cookedPath, const EString& sourcePath) const;
+
 	// Find all of the meshes in a scene and convert them to an EMesh
 	bool FindAndImportMeshes(const aiNode& node, const aiScene& scene, 
 		const aiMatrix4x4& parentTransform, EUi32* meshesCreated);
@@ -60,6 +140,18 @@ private:
 	// Array of materials for the model
 	TArray<TShared<ESMaterial>> m_materialStack;
 
+	// Material for the slots with no material when the model loads
+	TShared<ESMaterial> m_defaultMaterial;
+
+	// Data read by LoadData, freed once uploaded
+	TUnique<ESModelImportData> m_importData;
+
+	// Bounds of every mesh in model space
+	ESBounds m_bounds;
+
+	// Vertex cache miss ratio of every mesh before and after import optimisation
+	ESMeshOptimizeStats m_optimizeStats;
+
 	// Spawn ID
 	unsigned int m_spawnID;
 
@@ -0,0 +1,104 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Graphics/EMesh.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+class ETexture;
+class EShaderProgram;
+struct ESMaterial;
+
+// Passes are drawn in order, the pass is the top bits of the sort key
+enum EERenderPass : EUi8 {
+	RP_OPAQUE = 0U
+};
+
+// Everything needed to draw one mesh
+// The mesh, material and shader must stay alive until the queue is submitted
+struct ESDrawPacket {
+	EMesh* mesh = nullptr;
+	ESMaterial* material = nullptr;
+	EShaderProgram* shader = nullptr;
+
+	// Model matrix of the model the mesh belongs to
+	glm::mat4 model = glm::mat4(1.0f);
+};
+
+// Draw calls and state changes of the last submit
+struct ESRenderStats {
+	EUi32 drawCalls = 0;
+	EUi32 instances = 0;
+	EUi32 programChanges = 0;
+	EUi32 materialChanges = 0;
+	EUi32 textureBinds = 0;
+	EUi32 vaoBinds = 0;
+};
+
+// Collects the draws for a frame and submits them sorted so state only changes when it has to
+// Sorted draws of the same mesh, material and shader are drawn as one instanced draw
+// Each draw gets a 64 bit key
+// pass (4) | shader (8) | material (20) | vao (16) | depth (16)
+// so draws group by shader, then material, then mesh and go front to back inside a group
+class ERenderQueue {
+public:
+	ERenderQueue() = default;
+	~ERenderQueue();
+
+	// Start a new frame of draws seen from the view position
+	// Depth is measured from the view position up to the far clip
+	void Begin(const glm::vec3& viewPosition, float farClip);
+
+	// Add a draw to the queue
+	void Add(const ESDrawPacket& packet, EERenderPass pass = RP_OPAQUE);
+
+	// Sort and draw everything in the queue then empty it
+	// Shaders must have their frame uniforms set before submitting
+	// Shaders read the world and normal matrix from the instance attributes, not uniforms
+	// Pass the shader that is already active so it is not activated again
+	void Submit(EShaderProgram* activeShader = nullptr);
+
+	// Get the draw calls and state changes of the last submit
+	const ESRenderStats& GetStats() const { return m_stats; }
+
+	// Build the sort key for a draw
+	static EUi64 MakeKey(EERenderPass pass, EUi32 shaderID, EUi64 materialID, EUi32 vao, EUi16 depth);
+
+private:
+	// Sort key and the packet it belongs to
+	struct ESSortEntry {
+		EUi64 key;
+		EUi32 index;
+	};
+
+	// Number of texture units a material binds
+	static const EUi32 textureUnitCount = 3;
+
+	// Build the instance data in sorted order and upload it to the instance buffer
+	void UploadInstances();
+
+private:
+	// Packets added this frame
+	TArray<ESDrawPacket> m_packets;
+
+	// Keys of the packets, sorted on submit
+	TArray<ESSortEntry> m_entries;
+
+	// Instance data in sorted order, reused each frame
+	TArray<ESInstanceData> m_instances;
+
+	// Buffer the instance data is streamed to, created on the first submit
+	EUi32 m_instanceBuffer = 0;
+
+	// Size of the instance buffer in bytes
+	size_t m_instanceCapacity = 0;
+
+	// Position depth is measured from
+	glm::vec3 m_viewPosition = glm::vec3(0.0f);
+
+	// Distance that maps to the largest depth
+	float m_farClip = 1.0f;
+
+	// Stats of the last submit
+	ESRenderStats m_stats;
+};
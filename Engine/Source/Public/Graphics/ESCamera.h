@@ -1,5 +1,6 @@
 #pragma once
 #include "Math/ESTransform.h"
+#include "Math/ESFrustum.h"
 #include "Game/EGameEngine.h"
 
 struct ESCamera {
@@ -75,7 +76,44 @@ struct ESCamera {
 	// Get the vertical movement status for the camera
 	bool& GetVerticalMovementStatus() { return canMoveVertical; }
 
+	// Get the transform to render with, blended from the last tick by alpha
+	ESTransform GetRenderTransform(float alpha) const {
+		if (alpha >= 1.0f)
+			return transform;
+
+		return ESTransform::Lerp(previousTransform, transform, alpha);
+	}
+
+	// Get the view matrix from the camera blended by alpha
+	// Looks along the cameras forward and up vector
+	glm::mat4 GetViewMatrix(float alpha) const {
+		ESTransform renderTransform = GetRenderTransform(alpha);
+
+		return glm::lookAt(
+			renderTransform.position,
+			renderTransform.position + renderTransform.Forward(),
+			renderTransform.Up()
+		);
+	}
+
+	// Get the perspective projection matrix of the camera
+	glm::mat4 GetProjectionMatrix() const {
+		return glm::perspective(
+			glm::radians(fov),	// Zoom of camera
+			aspectRatio,		// How wide the view is
+			nearClip,			// How close 3D models can be seen
+			farClip				// How far 3D models can be seen
+		);						// - all other models will not render
+	}
+
+	// Get the planes of the camera view blended by alpha
+	ESFrustum GetFrustum(float alpha) const {
+		return ESFrustum::FromMatrix(GetProjectionMatrix() * GetViewMatrix(alpha));
+	}
+
 	ESTransform transform;
+	// Transform before the last fixed tick
+	ESTransform previousTransform;
 	float defaultFov;
 	float fov;
 	float aspectRatio;
@@ -0,0 +1,74 @@
+#pragma once
+#include "EngineTypes.h"
+#include "IO/ESFileStamp.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// Cooked model file, written next to the source model with the cookedMeshExtension
+// Layout is the header, one ESCookedMeshEntry per mesh, then the vertex and index data of each mesh
+// The data is stored exactly as it is uploaded so a mapped file can be handed straight to OpenGL
+//
+// Header				ESCookedModelHeader
+// Mesh entries			ESCookedMeshEntry x meshCount
+// Mesh data			packed vertices and indices, each aligned to cookedDataAlignment
+
+// Extension added to the source path
+const EString cookedMeshExtension = ".emesh";
+
+// "EMSH" read as a little endian integer
+const EUi32 cookedMeshMagic = 0x48534D45;
+
+// Increase when the layout, the vertex packing or the import optimisation changes so old files are recooked
+const EUi32 cookedMeshVersion = 1;
+
+// Alignment of each block of mesh data from the start of the file
+const EUi64 cookedDataAlignment = 16;
+
+struct ESCookedModelHeader {
+	EUi32 magic;
+	EUi32 version;
+
+	// ASSIMP flags the model was imported with
+	EUi32 importFlags;
+
+	// Number of mesh entries after the header
+	EUi32 meshCount;
+
+	// Number of material slots on the model
+	EUi32 materialCount;
+	EUi32 pad0;
+
+	// Source file the model was cooked from
+	ESFileStamp source;
+};
+
+struct ESCookedMeshEntry {
+	// Transform of the mesh relative to the model
+	glm::mat4 relativeTransform;
+
+	// Bounds of the vertex positions, see ESBounds
+	glm::vec3 boundsCenter;
+	float boundsRadius;
+	glm::vec3 boundsHalfSize;
+	EUi32 boundsValid;
+
+	// Material slot of the mesh
+	EUi32 materialIndex;
+
+	// Vertex layout, see ESVertexLayout
+	EUi8 attributes;
+	EUi8 texCoordFormat;
+	EUi8 pad0[2];
+
+	// Number of vertices and indices, indices are 16 bit with fewer than 65536 vertices
+	EUi32 vertexCount;
+	EUi32 indexCount;
+
+	// Byte offsets of the packed vertices and the indices from the start of the file
+	EUi64 vertexOffset;
+	EUi64 indexOffset;
+};
+
+static_assert(sizeof(ESCookedModelHeader) == 48, "Cooked model header must have no hidden padding");
+static_assert(sizeof(ESCookedMeshEntry) == 128, "Cooked mesh entry must have no hidden padding");
@@ -0,0 +1,78 @@
+#pragma once
+#include "EngineTypes.h"
+#include "IO/ESFileStamp.h"
+
+// System Libs
+#include <cstddef>
+
+// Cooked texture file, a DDS file written next to the source image with the cooked texture extension
+// The block compressed mips follow the header largest first, the way DDS tools expect
+// Rows are stored bottom up as OpenGL reads them, so other tools show the image upside down
+// The engine magic, version and source stamp are kept in the reserved space of the DDS header
+//
+// Header				ESCookedTextureHeader
+// Mip data				BC1, BC3 or BC5 blocks of every mip level
+
+// Extensions added to the source path, normal maps are cooked to their own file as they use a different format
+const EString cookedTextureExtension = ".cooked.dds";
+const EString cookedNormalMapExtension = ".normal.cooked.dds";
+
+// "DDS " read as a little endian integer
+const EUi32 ddsMagic = 0x20534444;
+
+// Four character codes of the block formats
+const EUi32 ddsFourCCBC1 = 0x31545844; // "DXT1"
+const EUi32 ddsFourCCBC3 = 0x35545844; // "DXT5"
+const EUi32 ddsFourCCBC5 = 0x32495441; // "ATI2"
+
+// DDS header and pixel format flags
+const EUi32 ddsFlagCaps = 0x1;
+const EUi32 ddsFlagHeight = 0x2;
+const EUi32 ddsFlagWidth = 0x4;
+const EUi32 ddsFlagPixelFormat = 0x1000;
+const EUi32 ddsFlagMipCount = 0x20000;
+const EUi32 ddsFlagLinearSize = 0x80000;
+const EUi32 ddsPixelFormatFourCC = 0x4;
+const EUi32 ddsCapsComplex = 0x8;
+const EUi32 ddsCapsTexture = 0x1000;
+const EUi32 ddsCapsMipMap = 0x400000;
+
+// "ETEX" read as a little endian integer, marks DDS files cooked by the engine
+const EUi32 cookedTextureMagic = 0x58455445;
+
+// Increase when the encoder or the mip filter changes so old files are recooked
+const EUi32 cookedTextureVersion = 2;
+
+struct ESCookedTextureHeader {
+	// DDS header
+	EUi32 magic;
+	EUi32 size;
+	EUi32 flags;
+	EUi32 height;
+	EUi32 width;
+	EUi32 linearSize;
+	EUi32 depth;
+	EUi32 mipCount;
+
+	// Reserved in the DDS header, used by the engine
+	EUi32 engineMagic;
+	EUi32 engineVersion;
+	ESFileStamp source;
+	EUi32 reserved[3];
+
+	// DDS pixel format
+	EUi32 pixelFormatSize;
+	EUi32 pixelFormatFlags;
+	EUi32 fourCC;
+	EUi32 rgbBitCount;
+	EUi32 bitMasks[4];
+
+	EUi32 caps;
+	EUi32 caps2;
+	EUi32 caps3;
+	EUi32 caps4;
+	EUi32 reserved2;
+};
+
+static_assert(sizeof(ESCookedTextureHeader) == 128, "Cooked texture header must match the DDS header");
+static_assert(offsetof(ESCookedTextureHeader, pixelFormatSize) == 76, "Cooked texture pixel format must match the DDS header");
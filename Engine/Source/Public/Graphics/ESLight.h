@@ -8,6 +8,7 @@ struct ESLight {
 		colour = glm::vec3(1.0f);
 		intensity = 0.0f;
 		isLightOn = true;
+		engineIndex = -1;
 	}
 
 	void ToggleLight() { isLightOn = !isLightOn;  }
@@ -18,6 +19,9 @@ struct ESLight {
 	glm::vec3 colour;
 	float intensity;
 	bool isLightOn;
+
+	// Index in the graphics engine light list so it can be removed without a search, -1 if not in the list
+	int engineIndex;
 };
 
 struct ESDirLight : public ESLight {
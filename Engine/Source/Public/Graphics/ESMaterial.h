@@ -45,9 +45,81 @@ struct ESMaterialSlot {
 	}
 };
 
+// Flags of the material maps
+enum EEMaterialMap : EUi8 {
+	MM_BASE_COLOUR = 1U << 0,
+	MM_SPECULAR = 1U << 1,
+	MM_NORMAL = 1U << 2
+};
+
+// Material values in the std140 layout of the shader material block
+struct ESMaterialParams {
+	float shininess;
+	float specularStrength;
+	float brightness;
+	float textureDepth;
+	int hasNormalMap;
+	int hasSpecularMap;
+	int pad0;
+	int pad1;
+};
+
 struct ESMaterial {
-	ESMaterial() = default;
+	ESMaterial();
+	~ESMaterial();
+
+	// Texture units the material maps are bound to
+	static const EUi32 baseColourUnit = 0;
+	static const EUi32 specularUnit = 1;
+	static const EUi32 normalUnit = 2;
+
+	// Uniform buffer binding point of the material block in the shaders
+	static const EUi32 parameterBinding = 0;
+
+	// Set the colour map for the material
+	void SetBaseColourMap(const TShared<ETexture>& map) { m_baseColourMap = map; ++m_version; }
+
+	// Set the specular map for the material
+	void SetSpecularMap(const TShared<ETexture>& map) { m_specularMap = map; ++m_version; }
+
+	// Set the normal map for the material
+	void SetNormalMap(const TShared<ETexture>& map) { m_normalMap = map; ++m_version; }
+
+	// Set the material properties
+	void SetShininess(float shininess) { m_shininess = shininess; ++m_version; }
+	void SetSpecularStrength(float specularStrength) { m_specularStrength = specularStrength; ++m_version; }
+	void SetBrightness(float brightness) { m_brightness = brightness; ++m_version; }
+	void SetTextureDepth(float textureDepth) { m_textureDepth = textureDepth; ++m_version; }
+
+	// Get the material maps
+	const TShared<ETexture>& GetBaseColourMap() const { return m_baseColourMap; }
+	const TShared<ETexture>& GetSpecularMap() const { return m_specularMap; }
+	const TShared<ETexture>& GetNormalMap() const { return m_normalMap; }
 
+	// Get the material properties
+	float GetShininess() const { return m_shininess; }
+	float GetSpecularStrength() const { return m_specularStrength; }
+	float GetBrightness() const { return m_brightness; }
+	float GetTextureDepth() const { return m_textureDepth; }
+
+	// Get the unique id of the material, never 0
+	EUi64 GetID() const { return m_id; }
+
+	// Get the version of the material, increased every time the material changes
+	EUi32 GetVersion() const { return m_version; }
+
+	// Bind the material maps to their texture units and the material block to its binding point
+	void Bind();
+
+	// Bind the material block to its binding point
+	// The block is only uploaded when the material changed since the last upload
+	void BindParameterBlock();
+
+	// Increase the version if a map finished uploading since the last check
+	// Maps still loading are not flagged in the material block so the shader ignores their placeholder
+	void UpdateMapReadiness();
+
+private:
 	// Colour map for the material
 	TShared<ETexture> m_baseColourMap;
 
@@ -72,4 +144,19 @@ struct ESMaterial {
 
 	// Texture depth of the material
 	float m_textureDepth = 1.0f;
+
+	// Unique id of the material
+	EUi64 m_id;
+
+	// Increased every time the material changes
+	EUi32 m_version;
+
+	// Version of the material in the uniform buffer
+	EUi32 m_uploadedVersion;
+
+	// EEMaterialMap flags of the maps that were ready at the last check
+	EUi8 m_readyMaps;
+
+	// Uniform buffer holding the material properties, created on the first bind
+	EUi32 m_parameterBuffer;
 };
\ No newline at end of file
@@ -4,9 +4,12 @@
 // External Libs
 #include <GLM/mat4x4.hpp>
 
+// System Libs
+#include <string_view>
+#include <unordered_map>
+
 class ETexture;
 struct ESCamera;
-struct ESLight;
 struct ESMaterial;
 
 // Enum to determine the type of shader
@@ -15,6 +18,29 @@ enum EEShaderType : EUi8 {
 	ST_FRAGMENT
 };
 
+// Uniforms the engine sets every draw
+// Located once when the shader links so draws never look up uniform names
+enum EEUniform : EUi8 {
+	U_MESH = 0U,
+	U_MODEL,
+	U_VIEW,
+	U_PROJECTION,
+	U_VIEW_PROJECTION,
+	U_TEXTURE_DEPTH,
+	U_BASE_COLOUR_MAP,
+	U_SPECULAR_MAP,
+	U_NORMAL_MAP,
+	U_ADDED_DIR_LIGHTS,
+	U_ADDED_POINT_LIGHTS,
+	U_ADDED_SPOT_LIGHTS,
+	U_BRIGHTNESS,
+	U_WIRE_COLOUR,
+	U_SPRITE,
+	U_SPRITE_COLOUR,
+	U_USE_TEXTURE,
+	U_COUNT
+};
+
 struct ESTransform;
 struct ESTransform2D;
 
@@ -24,6 +50,7 @@ public:
 	~EShaderProgram();
 
 	// Create the shader using a vertex and fragment file
+	// Loads the linked program from the program cache when the sources and driver match, otherwise compiles and caches it
 	bool InitShader(const EString& vShaderPath,
 		const EString& fShaderPath);
 
@@ -37,19 +64,20 @@ public:
 	// Set the transform of the model in the shader
 	void SetModelTransform(const ESTransform& transform);
 
+	// Set the model matrix in the shader
+	void SetModelMatrix(const glm::mat4& matModel);
+
 	// Set the 3D coordinates for the model
-	void SetWorldTransform(const TShared<ESCamera>& camera);
+	void SetWorldTransform(const TShared<ESCamera>& camera, float renderAlpha = 1.0f);
 
 	// Set the 2D coordinates for the sprite
 	void SetSpriteTransform(const ESTransform2D& transform);
 
-	// Set the lights in the shader
-	void SetLights(const TArray<TShared<ESLight>>& lights);
-
-	// Set the number of lights in the shader
+	// Set the number of lights in the shader light buffers
 	void SetNumberOfLights(const int& dirLights, const int& pointLights, const int& spotLights);
 
 	// Set the material in the shader
+	// Does nothing if the material is already set and has not changed
 	void SetMaterial(const TShared<ESMaterial>& material);
 
 	// Only works for wireframe shader
@@ -67,9 +95,29 @@ public:
 	// Get program ID
 	EUi32 GetProgramID() { return m_programID; }
 
+	// Get the location of an engine uniform, -1 if the shader does not use it
+	int GetUniformLocation(EEUniform uniform) const { return m_engineUniforms[uniform]; }
+
+	// Get the location of any uniform from its name hash, -1 if the shader does not use it
+	// Hash the name with HashName, use a constexpr hash to avoid hashing at runtime
+	int GetUniformLocation(EUi32 nameHash) const;
+
+	// Get the index of a uniform or shader storage block from its name hash, -1 if the shader does not use it
+	int GetBlockIndex(EUi32 nameHash) const;
+
+	// Hash a uniform or block name, FNV-1a
+	static constexpr EUi32 HashName(std::string_view name) {
+		EUi32 hash = 2166136261U;
+		for (const char c : name) {
+			hash ^= (EUi8)c;
+			hash *= 16777619U;
+		}
+		return hash;
+	}
+
 private:
-	// Import a shader based on the shader type
-	bool ImportShaderByType(const EString& filePath, EEShaderType shaderType);
+	// Compile a shader from its source based on the shader type
+	bool CompileShader(const EString& shaderStr, EEShaderType shaderType);
 
 	// Convert a file into a string
 	EString ConvertFileToString(const EString& filePath);
@@ -77,6 +125,16 @@ private:
 	// Link the shader to the GPU through OpenGL
 	bool LinkToGPU();
 
+	// Load the program from a binary saved by the driver
+	// Fails if the binary was saved from other sources or by another driver
+	bool LoadProgramBinary(const EString& cachePath, EUi64 sourceHash);
+
+	// Save the linked program binary so the next launch skips compiling
+	void SaveProgramBinary(const EString& cachePath, EUi64 sourceHash) const;
+
+	// Find every active uniform and block in the linked program and store their locations
+	void ReflectUniforms();
+
 private:
 	// Store the file paths
 	EString m_filePath[2] = { "", "" };
@@ -90,4 +148,17 @@ private:
 	// Depth of the texture size
 	float m_textureDepth;
 	float m_defaultTextureDepth;
+
+	// Locations of every active uniform by name hash
+	std::unordered_map<EUi32, int> m_uniformLocations;
+
+	// Indices of every active uniform and shader storage block by name hash
+	std::unordered_map<EUi32, int> m_blockIndices;
+
+	// Locations of the engine uniforms
+	int m_engineUniforms[U_COUNT];
+
+	// Material set since the shader was last activated, 0 if none
+	EUi64 m_boundMaterialID;
+	EUi32 m_boundMaterialVersion;
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "Graphics/EShaderProgram.h"
 #include "Math/ESTransform.h"
 
-class ESprite : public EMesh, public ETexture {
+class ESprite : public EMesh {
 public:
 	ESprite() { 
 		m_transform = ESTransform2D(); 
@@ -45,7 +45,16 @@ public:
 	ESTransform2D& GetTransform() { return m_transform; }
 
 	// Set scale to match texture
-	void SetScaleToTextureSize() { m_transform.scale = glm::vec2(static_cast<float>(m_width), static_cast<float>(m_height)); }
+	void SetScaleToTextureSize() {
+		if (m_texture)
+			m_transform.scale = glm::vec2(static_cast<float>(m_texture->GetWidth()), static_cast<float>(m_texture->GetHeight()));
+	}
+
+	// Get the texture, null if the sprite has no texture
+	const TShared<ETexture>& GetTexture() const { return m_texture; }
+
+	// Get the import path of the texture, empty if the sprite has no texture
+	EString GetTexturePath() const { return m_texture ? m_texture->GetImportPath() : ""; }
 
 	// Set render order
 	void SetRenderOrder(const EUi32 renderOrder) { m_renderOrder = renderOrder; }
@@ -67,6 +76,9 @@ public:
 	glm::vec2& GetRenderScale() { return m_renderScale; }
 
 protected:
+	// Texture from the engine asset cache, shared with every sprite using the same image
+	TShared<ETexture> m_texture;
+
 	ESTransform2D m_transform;
 
 	EUi32 m_renderOrder;
@@ -1,7 +1,16 @@
 #pragma once
 #include "EngineTypes.h"
+#include "Graphics/EAsset.h"
+#include "Graphics/ETextureCompressor.h"
+#include "IO/EMappedFile.h"
 
-class ETexture {
+// What a texture is sampled for, normal maps are compressed to a two channel format
+enum EETextureType : EUi8 {
+	TT_COLOUR = 0U,
+	TT_NORMAL
+};
+
+class ETexture : public EAsset {
 public:
 	ETexture();
 	~ETexture();
@@ -9,6 +18,12 @@ public:
 	// Import a file and convert it to a texture
 	bool LoadTexture(const EString& fileName, const EString& path, bool repeat = true, bool linear = true);
 
+	// Set the file to import without loading it, used to load the texture with the asset manager
+	void SetSource(const EString& fileName, const EString& path, bool repeat = true, bool linear = true, EETextureType type = TT_COLOUR);
+
+	// Set the texture bound in place of textures that have not uploaded yet
+	static void SetPlaceholder(EUi32 textureID) { s_placeholderID = textureID; }
+
 	// Activates the texture to use for OpenGL
 	void BindTexture(const EUi32& textureNumber);
 
@@ -26,7 +41,55 @@ public:
 
 	// Get the number of channels
 	int GetChannels() const { return m_channels; }
+
+	// Get the size of the image in pixels
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+
+	// Get the format the texture is stored in on the GPU
+	EETextureFormat GetFormat() const { return m_format; }
+
+	// Get the size of the image and its mip maps in bytes
+	size_t GetMemorySize() const;
+
+	// Cook an image to a compressed texture without OpenGL
+	// Does nothing if it is already cooked from the current source, returns false if it failed
+	static bool CookTexture(const EString& path, EETextureType type);
+
+	// Cook every image in a folder and its sub folders, returns false if any failed
+	static bool CookFolder(const EString& folder);
+
+	// Get what an image is sampled for from its file name
+	static EETextureType GetTypeFromName(const EString& path);
+
+	// Get the path an image is cooked to
+	static EString GetCookedPath(const EString& path, EETextureType type);
 	
+protected:
+	// Decode the image with STB, runs on any thread
+	bool LoadData() override;
+
+	// Upload the decoded image and build the mip maps
+	bool UploadData() override;
+
+	// Get the size of the image and its mip maps in bytes
+	size_t GetUploadSize() const override;
+
+	// Use the cooked texture if it was cooked from the current source
+	bool LoadCookedTexture(const EString& cookedPath);
+
+	// Decode the source image with STB
+	bool DecodeImage();
+
+	// Compress the decoded image and free it
+	bool CompressTexture();
+
+	// Write the compressed image to the cooked texture file so the next launch skips decoding and compressing
+	bool SaveCookedTexture(const EString& cookedPath) const;
+
+	// Upload every compressed mip level
+	void UploadCompressedMips();
+
 protected:
 	// Import path of the image
 	EString m_path;
@@ -39,4 +102,31 @@ protected:
 
 	// Texture parameters
 	int m_width, m_height, m_channels;
+
+	// Sampler settings used when the texture uploads
+	bool m_repeat, m_linear;
+
+	// Decoded image waiting to be uploaded
+	unsigned char* m_pixels;
+
+	// What the texture is sampled for
+	EETextureType m_type;
+
+	// Format on the GPU and the number of mip levels of compressed textures
+	EETextureFormat m_format;
+	EUi32 m_mipCount;
+
+	// Compressed mips from the cooked file or the compressor, kept until they are uploaded
+	struct ESCompressedImportData {
+		EMappedFile cookedFile;
+		ESCompressedImage image;
+
+		// Start of the mips in the cooked file or the image
+		const EUi8* mipData = nullptr;
+	};
+
+	TUnique<ESCompressedImportData> m_compressedData;
+
+	// Texture bound while a texture is still loading
+	static EUi32 s_placeholderID;
 };
\ No newline at end of file
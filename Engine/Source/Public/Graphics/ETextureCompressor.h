@@ -0,0 +1,73 @@
+#pragma once
+#include "EngineTypes.h"
+
+// Formats a texture can be stored in on the GPU
+enum EETextureFormat : EUi8 {
+	TF_UNCOMPRESSED = 0U,
+	TF_BC1,	// RGB, 4 bits per pixel
+	TF_BC3,	// RGBA, 8 bits per pixel
+	TF_BC5	// Two channel normal map, 8 bits per pixel
+};
+
+// Block compressed image with every mip level, largest first
+struct ESCompressedImage {
+	EETextureFormat format = TF_UNCOMPRESSED;
+	EUi32 width = 0;
+	EUi32 height = 0;
+	EUi32 mipCount = 0;
+
+	// Blocks of each mip level packed one after the other
+	TArray<EUi8> data;
+};
+
+// CPU encoder for the BC1, BC3 and BC5 block formats
+// Images are split into 4x4 pixel blocks that are compressed on their own
+// Colour blocks store two 565 end points along the main axis of the block colours and a 2 bit index per pixel
+// Channel blocks store two 8 bit end points and a 3 bit index per pixel
+// Uses no OpenGL so it runs on any thread and in headless runs
+class ETextureCompressor {
+public:
+	// Get the number of bytes in one 4x4 block
+	static EUi32 GetBlockSize(EETextureFormat format) { return format == TF_BC1 ? 8 : 16; }
+
+	// Get the number of bytes in one mip level
+	static size_t GetMipSize(EETextureFormat format, EUi32 width, EUi32 height);
+
+	// Get the number of bytes in an image with mipCount levels
+	static size_t GetImageSize(EETextureFormat format, EUi32 width, EUi32 height, EUi32 mipCount);
+
+	// Get the number of mip levels down to 1x1
+	static EUi32 GetMipCount(EUi32 width, EUi32 height);
+
+	// Pick a format for an image
+	// Normal maps use BC5, images with transparent pixels use BC3 and everything else BC1
+	static EETextureFormat ChooseFormat(const EUi8* pixels, EUi32 width, EUi32 height, int channels, bool normalMap);
+
+	// Compress an image with 3 or 4 channels and build every mip level from it
+	// BC5 images are treated as normal maps, their mips are renormalised
+	static bool Compress(const EUi8* pixels, EUi32 width, EUi32 height, int channels,
+		EETextureFormat format, ESCompressedImage& image);
+
+	// Encode one 4x4 block of RGBA pixels
+	static void EncodeBlock(EETextureFormat format, const EUi8* rgba, EUi8* block);
+
+	// Decode one block to 4x4 RGBA pixels, used to measure the error of the encoder
+	static void DecodeBlock(EETextureFormat format, const EUi8* block, EUi8* rgba);
+
+	// Decode a whole mip level to RGBA pixels
+	static void DecodeMip(EETextureFormat format, const EUi8* data, EUi32 width, EUi32 height, TArray<EUi8>& rgba);
+
+private:
+	// Encode the RGB of a block as a BC1 colour block
+	static void EncodeColourBlock(const EUi8* rgba, EUi8* block);
+
+	// Encode one channel of a block as a BC4 channel block
+	static void EncodeChannelBlock(const EUi8* rgba, int channel, EUi8* block);
+
+	static void DecodeColourBlock(const EUi8* block, EUi8* rgba);
+	static void DecodeChannelBlock(const EUi8* block, int channel, EUi8* rgba);
+
+	// Halve an RGBA image with a box filter, normal maps are renormalised
+	static void DownsampleMip(const TArray<EUi8>& source, EUi32 width, EUi32 height,
+		TArray<EUi8>& mip, bool normalMap);
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "EngineTypes.h"
+
+// Read only view of a whole file mapped into memory
+// Pages are read from disk by the OS as they are touched so nothing is copied on open
+class EMappedFile {
+public:
+	EMappedFile();
+	~EMappedFile();
+
+	EMappedFile(const EMappedFile&) = delete;
+	EMappedFile& operator=(const EMappedFile&) = delete;
+
+	// Map a file, closes any file already mapped
+	bool Open(const EString& path);
+
+	// Unmap the file
+	void Close();
+
+	// Check if a file is mapped
+	bool IsOpen() const { return m_data != nullptr; }
+
+	// Get the start of the file in memory
+	const EUi8* GetData() const { return m_data; }
+
+	// Get the size of the file in bytes
+	size_t GetSize() const { return m_size; }
+
+private:
+	// Start of the mapped file
+	const EUi8* m_data;
+
+	// Size of the mapped file in bytes
+	size_t m_size;
+
+	// OS handles for the file and the mapping
+	void* m_fileHandle;
+	void* m_mappingHandle;
+};
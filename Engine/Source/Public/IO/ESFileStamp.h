@@ -0,0 +1,25 @@
+#pragma once
+#include "EngineTypes.h"
+
+// Identifies the version of a source file that cooked data was built from
+// The size and write time are checked first so unchanged files are never read
+struct ESFileStamp {
+	// Read the stamp of a file, returns false if the file can't be read
+	static bool FromFile(const EString& path, ESFileStamp& stamp);
+
+	// Hash bytes with 64 bit FNV-1a
+	static EUi64 HashBytes(const EUi8* data, size_t size);
+
+	// Check if a file still matches the stamp
+	// The file is only hashed when its size or write time changed, so touching a file doesn't count as a change
+	bool Matches(const EString& path) const;
+
+	// Size of the file in bytes
+	EUi64 size = 0;
+
+	// Last write time of the file in file clock ticks
+	EUi64 writeTime = 0;
+
+	// Hash of the file contents
+	EUi64 hash = 0;
+};
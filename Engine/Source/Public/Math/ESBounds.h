@@ -0,0 +1,97 @@
+#pragma once
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// Axis aligned box and bounding sphere around the same center
+struct ESBounds {
+	ESBounds() {
+		center = glm::vec3(0.0f);
+		halfSize = glm::vec3(0.0f);
+		radius = 0.0f;
+		isValid = false;
+	}
+
+	// Build bounds around a set of points
+	static ESBounds FromPoints(const glm::vec3* points, size_t count, size_t stride = sizeof(glm::vec3)) {
+		ESBounds bounds;
+		if (count == 0)
+			return bounds;
+
+		const char* bytes = reinterpret_cast<const char*>(points);
+
+		// Find the box around every point
+		glm::vec3 min = *points;
+		glm::vec3 max = *points;
+		for (size_t i = 1; i < count; ++i) {
+			const glm::vec3& point = *reinterpret_cast<const glm::vec3*>(bytes + i * stride);
+			min = glm::min(min, point);
+			max = glm::max(max, point);
+		}
+
+		bounds.center = (min + max) * 0.5f;
+		bounds.halfSize = (max - min) * 0.5f;
+
+		// The sphere only needs to reach the furthest point, which is often tighter than the box corners
+		float radiusSqr = 0.0f;
+		for (size_t i = 0; i < count; ++i) {
+			const glm::vec3 offset = *reinterpret_cast<const glm::vec3*>(bytes + i * stride) - bounds.center;
+			radiusSqr = glm::max(radiusSqr, glm::dot(offset, offset));
+		}
+
+		bounds.radius = glm::sqrt(radiusSqr);
+		bounds.isValid = true;
+		return bounds;
+	}
+
+	// Get the bounds after a transform, the box stays axis aligned so grows to fit
+	ESBounds Transformed(const glm::mat4& matrix) const {
+		ESBounds bounds;
+		if (!isValid)
+			return bounds;
+
+		bounds.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+
+		// Each axis of the new box is the sum of the absolute rotated axes
+		const glm::mat3 absolute = glm::mat3(
+			glm::abs(glm::vec3(matrix[0])), glm::abs(glm::vec3(matrix[1])), glm::abs(glm::vec3(matrix[2])));
+		bounds.halfSize = absolute * halfSize;
+
+		// Largest scale of the matrix stretches the sphere the most
+		const float maxScale = glm::max(glm::length(glm::vec3(matrix[0])),
+			glm::max(glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2]))));
+		bounds.radius = radius * maxScale;
+		bounds.isValid = true;
+		return bounds;
+	}
+
+	// Grow the bounds to contain other bounds
+	void Merge(const ESBounds& other) {
+		if (!other.isValid)
+			return;
+
+		if (!isValid) {
+			*this = other;
+			return;
+		}
+
+		const glm::vec3 min = glm::min(center - halfSize, other.center - other.halfSize);
+		const glm::vec3 max = glm::max(center + halfSize, other.center + other.halfSize);
+		const glm::vec3 newCenter = (min + max) * 0.5f;
+
+		// Sphere around the new center that holds both spheres
+		radius = glm::max(glm::length(center - newCenter) + radius,
+			glm::length(other.center - newCenter) + other.radius);
+		center = newCenter;
+		halfSize = (max - min) * 0.5f;
+	}
+
+	// Center of the box and sphere
+	glm::vec3 center;
+	// Size of the box from the center
+	glm::vec3 halfSize;
+	// Radius of the sphere
+	float radius;
+	// False until the bounds contain something
+	bool isValid;
+};
@@ -2,6 +2,9 @@
 #include "Math/ESBox.h"
 #include "EngineTypes.h"
 
+// External Libs
+#include <GLM/gtc/matrix_transform.hpp>
+
 enum class EECollisionType {
 	ALL,
 	COLLECTABLE,
@@ -21,6 +24,7 @@ struct ESCollision {
 		debugColour = glm::vec3(0.0f, 1.0f, 0.0f);
 		type = EECollisionType::ALL;
 		tag = "";
+		UpdateDebugMatrix();
 	}
 
 	ESCollision(const ESBox& newBox) {
@@ -29,6 +33,18 @@ struct ESCollision {
 		debugColour = glm::vec3(0.0f, 1.0f, 0.0f);
 		type = EECollisionType::ALL;
 		tag = "";
+		UpdateDebugMatrix();
+	}
+
+	// Move the box and its debug wireframe
+	void MoveTo(const glm::vec3& position) {
+		box.position = position;
+		UpdateDebugMatrix();
+	}
+
+	// Rebuild the debug wireframe matrix from the box
+	void UpdateDebugMatrix() {
+		debugMatrix = glm::scale(glm::translate(glm::mat4(1.0f), box.position), box.halfSize);
 	}
 
 	// Determine if two collisions are overlapping
@@ -42,6 +58,9 @@ struct ESCollision {
 	// Colour of the debug wireframe;
 	glm::vec3 debugColour;
 
+	// Model matrix of the debug wireframe, only rebuilt when the box moves
+	glm::mat4 debugMatrix;
+
 	// Collision type
 	EECollisionType type;
 
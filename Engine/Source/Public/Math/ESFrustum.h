@@ -0,0 +1,54 @@
+#pragma once
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// Planes of a camera view, the normals point inside
+// Each plane is stored as xyz normal and w distance so a point is inside when dot(normal, point) + w > 0
+struct ESFrustum {
+	enum EEPlane : unsigned char {
+		P_LEFT = 0U,
+		P_RIGHT,
+		P_BOTTOM,
+		P_TOP,
+		P_NEAR,
+		P_FAR,
+		P_COUNT
+	};
+
+	// Get the planes from a projection * view matrix
+	static ESFrustum FromMatrix(const glm::mat4& viewProjection) {
+		// Rows of the matrix, glm stores columns
+		const glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+		const glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+		const glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+		const glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+		ESFrustum frustum;
+		frustum.planes[P_LEFT] = row3 + row0;
+		frustum.planes[P_RIGHT] = row3 - row0;
+		frustum.planes[P_BOTTOM] = row3 + row1;
+		frustum.planes[P_TOP] = row3 - row1;
+		frustum.planes[P_NEAR] = row3 + row2;
+		frustum.planes[P_FAR] = row3 - row2;
+
+		// Normalise so distances to the planes are in world units
+		for (glm::vec4& plane : frustum.planes) {
+			plane /= glm::length(glm::vec3(plane));
+		}
+
+		return frustum;
+	}
+
+	// Check if a sphere is at least partly inside the frustum
+	bool IntersectsSphere(const glm::vec3& center, float radius) const {
+		for (const glm::vec4& plane : planes) {
+			if (glm::dot(glm::vec3(plane), center) + plane.w <= -radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	glm::vec4 planes[P_COUNT];
+};
@@ -18,7 +18,7 @@ struct ESTransform {
 	}
 
 	// Get the forward vector of the local rotation
-	glm::vec3 Forward() {
+	glm::vec3 Forward() const {
 		glm::vec3 forward = glm::vec3(0.0f);
 
 		// Get the forward x value by * sin of y by cos of x
@@ -35,7 +35,7 @@ struct ESTransform {
 		return forward;
 	}
 
-	glm::vec3 Right() {
+	glm::vec3 Right() const {
 		// Get the right value by crossing the forward and world up vector
 		glm::vec3 right = glm::cross(Forward(), glm::vec3(0.0f, 1.0f, 0.0f));
 
@@ -46,7 +46,7 @@ struct ESTransform {
 		return right;
 	}
 
-	glm::vec3 Up() {
+	glm::vec3 Up() const {
 		// Get the up value by crossing the right and forward local direction vectors
 		glm::vec3 up = glm::cross(Right(), Forward());
 
@@ -57,6 +57,47 @@ struct ESTransform {
 		return up;
 	}
 
+	// Set the position and rebuild the matrices on the next get
+	void SetPosition(const glm::vec3& newPosition) {
+		position = newPosition;
+		m_isDirty = true;
+	}
+
+	// Set the rotation and rebuild the matrices on the next get
+	void SetRotation(const glm::vec3& newRotation) {
+		rotation = newRotation;
+		m_isDirty = true;
+	}
+
+	// Set the scale and rebuild the matrices on the next get
+	void SetScale(const glm::vec3& newScale) {
+		scale = newScale;
+		m_isDirty = true;
+	}
+
+	// Rebuild the matrices on the next get
+	// Needed after writing the fields directly
+	void MarkDirty() { m_isDirty = true; }
+
+	// Get the model matrix of the transform
+	// Only rebuilt when the transform is dirty
+	const glm::mat4& GetMatrix() const {
+		UpdateMatrices();
+		return m_matrix;
+	}
+
+	// Get the matrix that moves normals into world space
+	// Only rebuilt when the transform is dirty
+	const glm::mat3& GetNormalMatrix() const {
+		UpdateMatrices();
+		return m_normalMatrix;
+	}
+
+	// Compare the position, rotation and scale
+	bool operator==(const ESTransform& other) const {
+		return position == other.position && rotation == other.rotation && scale == other.scale;
+	}
+
 	ESTransform operator+(const ESTransform& other) const {
 		return {
 			position + other.position,
@@ -69,9 +110,49 @@ struct ESTransform {
 		return *this = *this + other;
 	}
 
+	// Blend between two transforms by alpha from 0 to 1
+	// Rotation takes the shortest way around so wrapped angles don't spin
+	static ESTransform Lerp(const ESTransform& from, const ESTransform& to, float alpha) {
+		glm::vec3 rotationDelta = to.rotation - from.rotation;
+		rotationDelta -= glm::round(rotationDelta / 360.0f) * 360.0f;
+
+		return {
+			glm::mix(from.position, to.position, alpha),
+			from.rotation + rotationDelta * alpha,
+			glm::mix(from.scale, to.scale, alpha)
+		};
+	}
+
+	// Use the setters or MarkDirty when changing a transform that uses its matrices
 	glm::vec3 position;
 	glm::vec3 rotation;
 	glm::vec3 scale;
+
+private:
+	// Rebuild the matrices if the transform is dirty
+	void UpdateMatrices() const {
+		if (!m_isDirty)
+			return;
+
+		// Translate (move) > rotate > scale so the rotation is around the new location
+		glm::mat4 matrixT = glm::translate(glm::mat4(1.0f), position);
+
+		matrixT = glm::rotate(matrixT, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+		matrixT = glm::rotate(matrixT, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+		matrixT = glm::rotate(matrixT, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+
+		m_matrix = glm::scale(matrixT, scale);
+		m_normalMatrix = glm::transpose(glm::inverse(glm::mat3(m_matrix)));
+
+		m_isDirty = false;
+	}
+
+	// Matrices built from the transform
+	mutable glm::mat4 m_matrix = glm::mat4(1.0f);
+	mutable glm::mat3 m_normalMatrix = glm::mat3(1.0f);
+
+	// Whether the transform changed since the matrices were built
+	mutable bool m_isDirty = true;
 };
 
 struct ESTransform2D {
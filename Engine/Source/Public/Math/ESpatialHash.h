@@ -0,0 +1,94 @@
+#pragma once
+#include "EngineTypes.h"
+#include "Math/ESBox.h"
+
+// External Libs
+#include <GLM/glm.hpp>
+
+// Uniform grid broadphase for collision boxes
+// Boxes are hashed into every cell they touch and only boxes sharing a cell are reported as pairs
+class ESpatialHash {
+public:
+	ESpatialHash(float cellSize = 50.0f, EUi32 maxCellsPerBox = 64);
+
+	// Remove all boxes, keeps memory allocated for the next frame
+	void Clear();
+
+	// Add a box to the grid with an owner id
+	// Boxes with the same owner id are never paired together
+	void Insert(const ESBox& box, EUi32 ownerID);
+
+	// Build the grid and return every unique owner pair that shares a cell
+	// Each pair is returned once with the lower owner id first
+	const TArray<std::pair<EUi32, EUi32>>& FindPairs();
+
+	// Build the grid from the inserted boxes so it can be queried
+	void Build();
+
+	// Add the owner id of every built box that shares a cell with the box to the owners
+	// Each owner is added once, Build must be called after the last Insert
+	void Query(const ESBox& box, TArray<EUi32>& owners) const;
+
+	// Set the size of each grid cell in world units
+	void SetCellSize(float cellSize) { m_cellSize = cellSize; m_invCellSize = 1.0f / cellSize; }
+
+	// Get the size of each grid cell in world units
+	float GetCellSize() const { return m_cellSize; }
+
+	// Get the number of boxes inserted this frame
+	EUi32 GetBoxCount() const { return (EUi32)m_boxes.size(); }
+
+private:
+	struct ESHashBox {
+		glm::ivec3 minCell;
+		glm::ivec3 maxCell;
+		ESBox box;
+		EUi32 ownerID;
+	};
+
+	struct ESHashEntry {
+		glm::ivec3 cell;
+		EUi32 boxIndex;
+	};
+
+	// Get the cell coordinate for a world position
+	glm::ivec3 GetCell(const glm::vec3& position) const;
+
+	// Hash a cell coordinate into a bucket index
+	EUi32 HashCell(const glm::ivec3& cell) const;
+
+	// Add a pair of owners to the pair list
+	void AddPair(EUi32 ownerA, EUi32 ownerB);
+
+	// Check if a box covers too many cells to be hashed
+	bool IsLargeBox(const ESHashBox& hashBox) const;
+
+private:
+	// Size of each cell
+	float m_cellSize;
+	float m_invCellSize;
+
+	// Boxes covering more cells than this are tested against every box instead
+	EUi32 m_maxCellsPerBox;
+
+	// Boxes inserted this frame
+	TArray<ESHashBox> m_boxes;
+
+	// Indices of boxes that are too large to hash
+	TArray<EUi32> m_largeBoxes;
+
+	// Start of each bucket in the entry array, sized bucket count + 1
+	TArray<EUi32> m_bucketStarts;
+
+	// Cell entries sorted by bucket
+	TArray<ESHashEntry> m_entries;
+
+	// Packed owner pairs before removing duplicates
+	TArray<EUi64> m_packedPairs;
+
+	// Unique owner pairs found by the last FindPairs
+	TArray<std::pair<EUi32, EUi32>> m_pairs;
+
+	// Bucket mask, bucket count is always a power of 2
+	EUi32 m_bucketMask;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "EngineTypes.h"
+
+// System Libs
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Work stealing thread pool
+// Each worker has its own queue and steals from the other queues when it runs out of work
+// The thread that calls ParallelFor also works on the jobs until they are done
+class EJobSystem {
+public:
+	// Function run for a range of items, begin is inclusive and end is exclusive
+	typedef std::function<void(EUi32 begin, EUi32 end)> EJobFunc;
+
+	// Function run once in the background
+	typedef std::function<void()> ETaskFunc;
+
+	// 0 threads uses one thread per core, minus the calling thread
+	EJobSystem(EUi32 threadCount = 0);
+	~EJobSystem();
+
+	// Split count items into chunks and run func over each chunk across all workers
+	// Returns when every chunk has finished
+	// Chunks will be at least minChunkSize items so small jobs are not split too far
+	void ParallelFor(EUi32 count, EUi32 minChunkSize, const EJobFunc& func);
+
+	// Queue a task to run on a worker thread without waiting for it
+	// Tasks only run on the worker threads after any ParallelFor jobs so they never hold up the calling thread
+	// Runs the task straight away if there are no worker threads
+	void Schedule(const ETaskFunc& task);
+
+	// Get the number of workers including the calling thread
+	EUi32 GetWorkerCount() const { return (EUi32)m_queues.size(); }
+
+	// Get the index of the worker running on this thread
+	// The main thread is always 0
+	static EUi32 GetWorkerIndex();
+
+private:
+	struct ESJob {
+		const EJobFunc* func = nullptr;
+		EUi32 begin = 0;
+		EUi32 end = 0;
+		std::atomic<EUi32>* remaining = nullptr;
+	};
+
+	struct ESJobQueue {
+		std::mutex mutex;
+		std::deque<ESJob> jobs;
+	};
+
+	// Loop run by each worker thread
+	void WorkerLoop(EUi32 workerIndex);
+
+	// Pop a job from the workers own queue or steal one from another queue and run it
+	// Worker threads run a background task when there are no jobs
+	// Returns false if nothing was found
+	bool RunJob(EUi32 workerIndex);
+
+private:
+	// One queue per worker, index 0 belongs to the thread calling ParallelFor
+	TArray<TUnique<ESJobQueue>> m_queues;
+
+	// Worker threads
+	TArray<std::thread> m_threads;
+
+	// Background tasks, run in the order they were scheduled
+	std::mutex m_taskMutex;
+	std::deque<ETaskFunc> m_tasks;
+
+	// Sleeping workers wait on this until jobs are queued
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wakeCondition;
+
+	// Number of jobs and tasks waiting in the queues
+	std::atomic<EUi32> m_queuedJobs;
+
+	// Set when the workers should exit
+	std::atomic<bool> m_shuttingDown;
+};
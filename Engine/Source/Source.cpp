@@ -1,10 +1,50 @@
 // Engine Libs
 #include "EngineTypes.h"
 #include "Game/EGameEngine.h"
+#include "Debug/EBenchmark.h"
+#include "Graphics/ETexture.h"
+
+// System Libs
+#include <cstdlib>
 
 int main(int argc, char* argv[]) {
 	int result = 0;
 
+	// Run a standalone benchmark instead of the game if requested
+	// Example: Engine.exe -bench collision, Engine.exe -bench draw, Engine.exe -bench texture, Engine.exe -bench compressor
+	for (int i = 1; i < argc - 1; ++i) {
+		if (EString(argv[i]) == "-bench") {
+			return EBenchmark::Run(argv[i + 1]) ? 0 : -1;
+		}
+	}
+
+	// Cook every texture in the content folders instead of running the game
+	// Textures not cooked ahead are cooked the first time they load in the background
+	// Textures loaded on the main thread are not compressed until they are cooked
+	// Example: Engine.exe -cook
+	for (int i = 1; i < argc; ++i) {
+		if (EString(argv[i]) == "-cook") {
+			bool cooked = true;
+			for (const EString folder : { "Textures", "Models" })
+				cooked = ETexture::CookFolder(folder) && cooked;
+
+			return cooked ? 0 : -1;
+		}
+	}
+
+	// Run the game without a window or OpenGL for a number of ticks
+	// Example: Engine.exe -headless 10000
+	for (int i = 1; i < argc; ++i) {
+		if (EString(argv[i]) == "-headless") {
+			EUi64 frameBudget = 0;
+			if (i + 1 < argc) {
+				frameBudget = std::strtoull(argv[i + 1], nullptr, 10);
+			}
+
+			EGameEngine::GetGameEngine()->SetHeadless(true, frameBudget);
+		}
+	}
+
 	// Initialise the engine
 	// Test if Init fails
 	if (!EGameEngine::GetGameEngine()->Run()) {